@@ -0,0 +1,40 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+static const char config[] = 
+"ARCH=      64bit-avx2-gcc\n"
+"CPPFLAGS=  \n"
+"DEFS=      -I../include -I. -D_FM_INTERNAL -D_FM_ALIGN=32\n"
+"ARCHFLAGS= -march=corei7 -mpc64 -mavx2 -mf16c -g\n"
+"GENFLAGS=  -falign-functions=32 -fPIC -fno-builtin\n"
+"OPTFLAGS=  -O3 -ffast-math -fexpensive-optimizations\n"
+"WARNFLAGS= -Wall -W\n"
+"LDLIBS=    -lpthread\n"
+"TESTLIBS=  -lrt -lm\n";
+
@@ -13,39 +13,72 @@ else
 include ../config/$(ARCH).inc
 default: all
 
+# the thread pool for the _mt batch functions
+LDLIBS += -lpthread
+
+# flags to enable OpenMP for the _omp batch functions
+OMPFLAGS ?= -fopenmp
+
 endif
 
 DEFS=-I../include -I. -D_FM_INTERNAL -D_FM_ALIGN=$(ALIGNMENT)
 CFLAGS= $(CPPFLAGS) $(DEFS) $(ARCHFLAGS) $(GENFLAGS) $(OPTFLAGS) $(WARNFLAGS)
-LIBSRC=exp.c exp_alt.c log.c log_alt.c erfc.c
+LIBSRC=exp.c exp_alt.c exp_tier.c exp_poly.c log.c log_alt.c log_tier.c log_poly.c erfc.c half.c threads.c sum_log.c log_int.c table.c log_compact.c log_accurate.c
 LIBOBJ=$(LIBSRC:.c=.o)
+OMPSRC=omp.c
+OMPOBJ=$(OMPSRC:.c=.o)
 TESTSRC=tester.c
 TESTOBJ=$(TESTSRC:.c=.o)
 GENPLSRC=genplot.c
 GENPLOBJ=$(GENPLSRC:.c=.o)
+CMPSRC=fmcompare.c
+CMPOBJ=$(CMPSRC:.c=.o)
 
 vpath %.c ../src
 vpath %.h ../include
 
-all: genspline libfastermath.so libfastermath.a fastermath.so tester genplot
+all: genspline genpoly libfastermath.so libfastermath.a fastermath.so tester genplot fmcompare \
+	libfastermath_omp.so libfastermath_omp.a
 
 genplot: $(GENPLOBJ) libfastermath.a
 	$(LD) $(ARCHFLAGS) -o $@ $^ $(TESTLIBS) $(LDLIBS)
 
-tester: $(TESTOBJ) libfastermath.a
-	$(LD) $(ARCHFLAGS) -o $@ $^ $(TESTLIBS) $(LDLIBS)
+# the tester calls the _omp batch functions from a parallel region
+$(TESTOBJ): %.o: %.c
+	$(CC) -o $@ -c $(CFLAGS) $(OMPFLAGS) $<
+
+tester: $(TESTOBJ) libfastermath_omp.a libfastermath.a
+	$(LD) $(ARCHFLAGS) $(OMPFLAGS) -o $@ $^ $(TESTLIBS) $(LDLIBS)
+
+fmcompare: $(CMPOBJ)
+	$(LD) $(ARCHFLAGS) -o $@ $^ -lm
 
 genspline: genspline.c
 	$(LD) $(ARCHFLAGS) $(CFLAGS) -o $@ $^ -lm
 
+# the remez solver needs full long double precision,
+# so it must not be compiled with -mpc64 or -ffast-math
+genpoly: genpoly.c
+	$(LD) $(DEFS) $(WARNFLAGS) -O2 -o $@ $^ -lm
+
 libfastermath.so: $(LIBOBJ)
-	$(LD) $(LDFLAGS) -o $@ $(LIBOBJ)
+	$(LD) $(LDFLAGS) -o $@ $(LIBOBJ) $(LDLIBS)
 
 libfastermath.a: $(LIBOBJ)
 	$(AR) $(ARFLAGS) $@ $(LIBOBJ)
 
+# the OpenMP batch functions are kept in a separate library
+$(OMPOBJ): %.o: %.c
+	$(CC) -o $@ -c $(CFLAGS) $(OMPFLAGS) $<
+
+libfastermath_omp.so: $(OMPOBJ)
+	$(LD) $(LDFLAGS) $(OMPFLAGS) -o $@ $(OMPOBJ) $(LDLIBS)
+
+libfastermath_omp.a: $(OMPOBJ)
+	$(AR) $(ARFLAGS) $@ $(OMPOBJ)
+
 fastermath.so: wrapper.c libfastermath.a
-	$(LD) $(LDFLAGS) $(CFLAGS) -o $@ $< libfastermath.a
+	$(LD) $(LDFLAGS) $(CFLAGS) -o $@ $< libfastermath.a $(LDLIBS)
 
 config.c: config-template.c
 	sed -e 's,@ARCH@,$(ARCH),' 		\
@@ -59,7 +92,7 @@ config.c: config-template.c
 		-e 's,@TESTLIBS@,$(TESTLIBS),'	\
 		$< > $@
 
-.depend: $(LIBSRC) $(TESTSRC) $(GENPLSRC) config.c
+.depend: $(LIBSRC) $(OMPSRC) $(TESTSRC) $(GENPLSRC) $(CMPSRC) config.c
 	$(CC) $(DEFS) $(CPPFLAGS) -MM $^ > $@
 
 .PHONY: all default
@@ -44,6 +44,12 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     FM_EXPORT_DECL type name(type)
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
+
+#define FM_FUNC_DECLV(type,name) \
+    FM_EXPORT_DECL void name(const type *, type *, size_t)
+
 /* prototypes for the exported interface */
 FM_FUNC_DECL1(double,fm_exp);
 FM_FUNC_DECL1(double,fm_exp2);
@@ -61,6 +67,14 @@ FM_FUNC_DECL1(float,fm_logf);
 FM_FUNC_DECL1(float,fm_log2f);
 FM_FUNC_DECL1(float,fm_log10f);
 
+FM_FUNC_DECL1(double,fm_log_ieee);
+FM_FUNC_DECL1(double,fm_log2_ieee);
+FM_FUNC_DECL1(double,fm_log10_ieee);
+
+FM_FUNC_DECL1(float,fm_logf_ieee);
+FM_FUNC_DECL1(float,fm_log2f_ieee);
+FM_FUNC_DECL1(float,fm_log10f_ieee);
+
 FM_FUNC_DECL1(double,fm_exp_alt);
 FM_FUNC_DECL1(double,fm_exp10_alt);
 
@@ -75,9 +89,188 @@ FM_FUNC_DECL1(float,fm_logf_alt);
 FM_FUNC_DECL1(float,fm_log2f_alt);
 FM_FUNC_DECL1(float,fm_log10f_alt);
 
+/* graded accuracy tiers. the suffix is the number of correct bits. */
+FM_FUNC_DECL1(float,fm_exp2f_p11);
+FM_FUNC_DECL1(float,fm_exp2f_p16);
+FM_FUNC_DECL1(float,fm_exp2f_p23);
+FM_FUNC_DECL1(float,fm_expf_p11);
+FM_FUNC_DECL1(float,fm_expf_p16);
+FM_FUNC_DECL1(float,fm_expf_p23);
+
+FM_FUNC_DECL1(double,fm_exp2_p24);
+FM_FUNC_DECL1(double,fm_exp2_p40);
+FM_FUNC_DECL1(double,fm_exp2_p52);
+FM_FUNC_DECL1(double,fm_exp_p24);
+FM_FUNC_DECL1(double,fm_exp_p40);
+FM_FUNC_DECL1(double,fm_exp_p52);
+
+FM_FUNC_DECL1(float,fm_log2f_p11);
+FM_FUNC_DECL1(float,fm_log2f_p16);
+FM_FUNC_DECL1(float,fm_log2f_p23);
+FM_FUNC_DECL1(float,fm_logf_p11);
+FM_FUNC_DECL1(float,fm_logf_p16);
+FM_FUNC_DECL1(float,fm_logf_p23);
+
+FM_FUNC_DECL1(double,fm_log2_p24);
+FM_FUNC_DECL1(double,fm_log2_p40);
+FM_FUNC_DECL1(double,fm_log2_p52);
+FM_FUNC_DECL1(double,fm_log_p24);
+FM_FUNC_DECL1(double,fm_log_p40);
+FM_FUNC_DECL1(double,fm_log_p52);
+
 FM_FUNC_DECL1(double,fm_erfc);
 FM_FUNC_DECL1(float,fm_erfcf);
 
+/* latency optimized variants with Estrin polynomial evaluation */
+FM_FUNC_DECL1(float,fm_exp2f_lat);
+FM_FUNC_DECL1(float,fm_expf_lat);
+FM_FUNC_DECL1(float,fm_expf_alt_lat);
+FM_FUNC_DECL1(float,fm_log2f_alt_lat);
+FM_FUNC_DECL1(double,fm_erfc_lat);
+
+/* variants written with explicit fused multiply-add operations */
+FM_FUNC_DECL1(double,fm_exp2_fma);
+FM_FUNC_DECL1(double,fm_exp_fma);
+FM_FUNC_DECL1(double,fm_exp10_fma);
+FM_FUNC_DECL1(double,fm_log2_fma);
+FM_FUNC_DECL1(double,fm_log_fma);
+FM_FUNC_DECL1(double,fm_log10_fma);
+FM_FUNC_DECL1(double,fm_erfc_fma);
+
+/* division free variants of 2**x, e**x and 10**x */
+FM_FUNC_DECL1(double,fm_exp2_poly);
+FM_FUNC_DECL1(double,fm_exp_poly);
+FM_FUNC_DECL1(double,fm_exp10_poly);
+
+/* batch interface: y[i] = f(x[i]) for i in [0:n[ */
+FM_FUNC_DECLV(double,fm_exp2_poly_v);
+FM_FUNC_DECLV(double,fm_exp_poly_v);
+FM_FUNC_DECLV(double,fm_exp10_poly_v);
+
+/* division and table free variants of log_2(x), log(x) and log_10(x) */
+FM_FUNC_DECL1(double,fm_log2_poly);
+FM_FUNC_DECL1(double,fm_log_poly);
+FM_FUNC_DECL1(double,fm_log10_poly);
+FM_FUNC_DECLV(double,fm_log2_poly_v);
+FM_FUNC_DECLV(double,fm_log_poly_v);
+FM_FUNC_DECLV(double,fm_log10_poly_v);
+
+/* log(x) with a 4 kB table, which stays in the L1 cache */
+FM_FUNC_DECL1(double,fm_log_compact);
+FM_FUNC_DECLV(double,fm_log_compact_v);
+
+/* log(x) with an error of less than 1 ulp */
+FM_FUNC_DECL1(double,fm_log_accurate);
+FM_FUNC_DECL1(double,fm_log2_accurate);
+FM_FUNC_DECL1(double,fm_log10_accurate);
+FM_FUNC_DECLV(double,fm_log_accurate_v);
+FM_FUNC_DECLV(double,fm_log2_accurate_v);
+FM_FUNC_DECLV(double,fm_log10_accurate_v);
+
+/* batch versions of the default functions. these use the
+ * division free kernels from above. */
+FM_FUNC_DECLV(double,fm_exp2_v);
+FM_FUNC_DECLV(double,fm_exp_v);
+FM_FUNC_DECLV(double,fm_exp10_v);
+FM_FUNC_DECLV(double,fm_log2_v);
+FM_FUNC_DECLV(double,fm_log_v);
+FM_FUNC_DECLV(double,fm_log10_v);
+
+/* streaming variants for arrays larger than the cache */
+FM_FUNC_DECLV(double,fm_exp2_v_stream);
+FM_FUNC_DECLV(double,fm_exp_v_stream);
+FM_FUNC_DECLV(double,fm_exp10_v_stream);
+FM_FUNC_DECLV(double,fm_log2_v_stream);
+FM_FUNC_DECLV(double,fm_log_v_stream);
+FM_FUNC_DECLV(double,fm_log10_v_stream);
+
+/* multi-threaded variants using an internal thread pool. the number
+ * of threads defaults to the FM_NUM_THREADS environment variable or
+ * the number of CPUs. */
+FM_FUNC_DECLV(double,fm_exp2_v_mt);
+FM_FUNC_DECLV(double,fm_exp_v_mt);
+FM_FUNC_DECLV(double,fm_exp10_v_mt);
+FM_FUNC_DECLV(double,fm_log2_v_mt);
+FM_FUNC_DECLV(double,fm_log_v_mt);
+FM_FUNC_DECLV(double,fm_log10_v_mt);
+
+/* strided and indexed batch functions for arrays of structures:
+ * name_strided(): y[i*incy] = f(x[i*incx]) for i in [0:n[
+ * name_idx():     y[idx[i]] = f(x[idx[i]]) for i in [0:n[ */
+#define FM_FUNC_DECL_STRIDED(name) \
+    FM_EXPORT_DECL void name(const double *, ptrdiff_t, double *, ptrdiff_t, size_t)
+#define FM_FUNC_DECL_IDX(name) \
+    FM_EXPORT_DECL void name(const double *, const int *, double *, size_t)
+
+FM_FUNC_DECL_STRIDED(fm_exp_strided);
+FM_FUNC_DECL_STRIDED(fm_log_strided);
+FM_FUNC_DECL_STRIDED(fm_erfc_strided);
+FM_FUNC_DECL_IDX(fm_exp_idx);
+FM_FUNC_DECL_IDX(fm_log_idx);
+FM_FUNC_DECL_IDX(fm_erfc_idx);
+
+/* masked batch functions: y[i] = f(x[i]) where mask[i] != 0,
+ * the other elements of y are not modified. */
+#define FM_FUNC_DECL_MASK(name) \
+    FM_EXPORT_DECL void name(const double *, const unsigned char *, double *, size_t)
+
+FM_FUNC_DECL_MASK(fm_exp_mask);
+FM_FUNC_DECL_MASK(fm_log_mask);
+FM_FUNC_DECL_MASK(fm_erfc_mask);
+
+/* fused accumulating batch functions: y[i] += a*f(b*x[i] + c) */
+#define FM_FUNC_DECL_AXPBY(name) \
+    FM_EXPORT_DECL void name(double, double, double, const double *, double *, size_t)
+
+FM_FUNC_DECL_AXPBY(fm_exp2_axpby);
+FM_FUNC_DECL_AXPBY(fm_exp_axpby);
+FM_FUNC_DECL_AXPBY(fm_log_axpby);
+FM_FUNC_DECL_AXPBY(fm_erfc_axpby);
+
+/* sum of log(x[i]) for i in [0:n[, i.e. the log of the product */
+FM_EXPORT_DECL double fm_sum_log(const double *, size_t);
+FM_EXPORT_DECL float fm_sum_logf(const float *, size_t);
+
+/* log(n) and n*log(n) for unsigned integers, from a table for n < 2**16 */
+FM_EXPORT_DECL double fm_log_u32(uint32_t);
+FM_EXPORT_DECL double fm_nlogn_u32(uint32_t);
+FM_EXPORT_DECL void fm_log_u32_v(const uint32_t *, double *, size_t);
+FM_EXPORT_DECL void fm_nlogn_u32_v(const uint32_t *, double *, size_t);
+
+/* cubic spline tables for arbitrary smooth functions in [lo:hi]
+ * with 2**bits intervals, created at runtime */
+typedef struct fm_table fm_table;
+FM_EXPORT_DECL fm_table *fm_table_create(double (*)(double), double, double, int);
+FM_EXPORT_DECL double fm_table_eval(const fm_table *, double);
+FM_EXPORT_DECL void fm_table_eval_v(const fm_table *, const double *, double *, size_t);
+FM_EXPORT_DECL void fm_table_free(fm_table *);
+
+FM_EXPORT_DECL void fm_set_num_threads(int);
+FM_EXPORT_DECL int fm_get_num_threads(void);
+
+/* variants for use inside OpenMP parallel regions, which share the
+ * work across the current team. these are in libfastermath_omp. */
+FM_FUNC_DECLV(double,fm_exp2_v_omp);
+FM_FUNC_DECLV(double,fm_exp_v_omp);
+FM_FUNC_DECLV(double,fm_exp10_v_omp);
+FM_FUNC_DECLV(double,fm_log2_v_omp);
+FM_FUNC_DECLV(double,fm_log_v_omp);
+FM_FUNC_DECLV(double,fm_log10_v_omp);
+
+/* batch functions for half precision (IEEE 754 binary16) and
+ * bfloat16 numbers, passed as their bit patterns */
+FM_FUNC_DECLV(unsigned short,fm_exp_f16_v);
+FM_FUNC_DECLV(unsigned short,fm_log_f16_v);
+FM_FUNC_DECLV(unsigned short,fm_sigmoid_f16_v);
+FM_FUNC_DECLV(unsigned short,fm_exp_bf16_v);
+FM_FUNC_DECLV(unsigned short,fm_log_bf16_v);
+FM_FUNC_DECLV(unsigned short,fm_sigmoid_bf16_v);
+
+FM_EXPORT_DECL void fm_f16_to_float_v(const unsigned short *, float *, size_t);
+FM_EXPORT_DECL void fm_float_to_f16_v(const float *, unsigned short *, size_t);
+FM_EXPORT_DECL void fm_bf16_to_float_v(const unsigned short *, float *, size_t);
+FM_EXPORT_DECL void fm_float_to_bf16_v(const float *, unsigned short *, size_t);
+
 #endif /* FASTERMATH_H */
 
 /* 
@@ -34,13 +34,212 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #error use fm_internal.h header only for building the library
 #endif 
 
+#include <stddef.h>
 #include <stdint.h>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 /* internal definitions for the fastermath library */
 
 /* favor spline table alternatives of log() functions */
 #define USE_LOG_SPLINE 1
 
+/* alias libm log() functions to the spline variants with IEEE-754
+ * conforming handling of zero, negative, inf, NaN and subnormal input */
+#define USE_LOG_IEEE 1
+
+/* use the explicit FMA kernels for the libm aliases, when compiling
+ * for CPUs with fused multiply-add instructions. */
+#if defined(__FMA__)
+#define USE_FMA_KERNELS 1
+#endif
+
+/* fused multiply-add a*b+c. this is a single instruction with a single
+ * rounding on FMA capable CPUs and a separate multiply and add otherwise,
+ * so it never turns into a (slow) call to the libm fma() function. */
+#if defined(__FMA__)
+#define FM_FMA(a,b,c)  __builtin_fma((a),(b),(c))
+#define FM_FMAF(a,b,c) __builtin_fmaf((a),(b),(c))
+#else
+#define FM_FMA(a,b,c)  ((a)*(b)+(c))
+#define FM_FMAF(a,b,c) ((a)*(b)+(c))
+#endif
+
+/* generate the batch version name_v() of a scalar function name()
+ * from its static inline kernel function. exported functions are not
+ * inlined when compiling position independent code, so the loop must
+ * call the kernel directly for the compiler to vectorize it. */
+#define FM_BATCH_DEF(type,name,kernel)                          \
+    void name ## _v(const type *x, type *y, size_t n)           \
+    {                                                           \
+        size_t i;                                               \
+        for (i = 0; i < n; ++i) y[i] = kernel(x[i]);            \
+    }
+
+/* generate strided and indexed batch versions name_strided() and
+ * name_idx() of a scalar function name() from its inline kernel.
+ * strided: y[i*incy] = name(x[i*incx]) for i in [0:n[
+ * indexed: y[idx[i]] = name(x[idx[i]]) for i in [0:n[
+ * this allows to operate on a field of an array of structures in
+ * place. the elements are gathered into a small buffer on the stack,
+ * the buffer is processed with the contiguous vector loop and then
+ * scattered back, so that the kernel loop does not depend on the
+ * access pattern. only the indexed gather loop is vectorized (to
+ * vgatherdpd with AVX2); the strided copies are scalar loops. */
+#define FM_BATCH_BLOCK 256
+
+#define FM_BATCH_STRIDED_DEF(name,kernel)                               \
+    void name ## _strided(const double *x, ptrdiff_t incx,              \
+                          double *y, ptrdiff_t incy, size_t n)          \
+    {                                                                   \
+        double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN))); \
+        size_t i, j, m;                                                 \
+        for (i = 0; i < n; i += m) {                                    \
+            m = (n - i < FM_BATCH_BLOCK) ? n - i : FM_BATCH_BLOCK;      \
+            for (j = 0; j < m; ++j) buf[j] = x[(i+j)*incx];             \
+            for (j = 0; j < m; ++j) buf[j] = kernel(buf[j]);            \
+            for (j = 0; j < m; ++j) y[(i+j)*incy] = buf[j];             \
+        }                                                               \
+    }
+
+#define FM_BATCH_IDX_DEF(name,kernel)                                   \
+    void name ## _idx(const double *x, const int *idx,                  \
+                      double *y, size_t n)                              \
+    {                                                                   \
+        double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN))); \
+        size_t i, j, m;                                                 \
+        for (i = 0; i < n; i += m) {                                    \
+            m = (n - i < FM_BATCH_BLOCK) ? n - i : FM_BATCH_BLOCK;      \
+            for (j = 0; j < m; ++j) buf[j] = x[idx[i+j]];               \
+            for (j = 0; j < m; ++j) buf[j] = kernel(buf[j]);            \
+            for (j = 0; j < m; ++j) y[idx[i+j]] = buf[j];               \
+        }                                                               \
+    }
+
+/* generate a masked batch version name_mask() of a scalar function
+ * name() from its inline kernel: y[i] = name(x[i]) for all i in [0:n[
+ * with mask[i] != 0, the other elements of y are left unchanged.
+ * the positions of the active elements of each block are compacted
+ * into an index list without branches, the active elements are
+ * evaluated densely and the results expanded back, so that the cost
+ * of the kernel is proportional to the number of active elements.
+ * blocks with more than half of the elements active are evaluated
+ * completely and blended into y instead, which is faster than the
+ * gather and scatter at that density. */
+#define FM_BATCH_MASK_DEF(name,kernel)                                  \
+    void name ## _mask(const double *x, const unsigned char *mask,      \
+                       double *y, size_t n)                             \
+    {                                                                   \
+        double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN))); \
+        int pos[FM_BATCH_BLOCK];                                        \
+        size_t i, j, m;                                                 \
+        int k, na;                                                      \
+        for (i = 0; i < n; i += m) {                                    \
+            m = (n - i < FM_BATCH_BLOCK) ? n - i : FM_BATCH_BLOCK;      \
+            for (j = 0, na = 0; j < m; ++j) na += (mask[i+j] != 0);     \
+            if (na == 0) continue;                                      \
+            if (2*na > (int)m) {                                        \
+                for (j = 0; j < m; ++j) buf[j] = kernel(x[i+j]);        \
+                for (j = 0; j < m; ++j)                                 \
+                    y[i+j] = mask[i+j] ? buf[j] : y[i+j];               \
+            } else {                                                    \
+                for (j = 0, na = 0; j < m; ++j) {                       \
+                    pos[na] = (int) j;                                  \
+                    na += (mask[i+j] != 0);                             \
+                }                                                       \
+                for (k = 0; k < na; ++k) buf[k] = x[i+pos[k]];          \
+                for (k = 0; k < na; ++k) buf[k] = kernel(buf[k]);       \
+                for (k = 0; k < na; ++k) y[i+pos[k]] = buf[k];          \
+            }                                                           \
+        }                                                               \
+    }
+
+/* generate a fused accumulating batch version name_axpby() of a
+ * scalar function name() from its inline kernel:
+ * y[i] += a*name(b*x[i] + c) for i in [0:n[
+ * so that the scaling of the argument and the result and the
+ * accumulation are done in the same pass over the data. */
+#define FM_BATCH_AXPBY_DEF(name,kernel)                                 \
+    void name ## _axpby(double a, double b, double c,                   \
+                        const double *x, double *y, size_t n)           \
+    {                                                                   \
+        size_t i;                                                       \
+        for (i = 0; i < n; ++i)                                         \
+            y[i] = FM_FMA(a, kernel(FM_FMA(b, x[i], c)), y[i]);         \
+    }
+
+/* streaming batch functions for arrays larger than the last level cache.
+ * the output is written in blocks of one cache line with non-temporal
+ * stores, which bypass the cache, and the input is prefetched
+ * FM_STREAM_PREFETCH bytes ahead. for output smaller than
+ * FM_STREAM_THRESHOLD bytes the regular loop is used. */
+#ifndef FM_STREAM_THRESHOLD
+#define FM_STREAM_THRESHOLD (8*1024*1024)
+#endif
+#ifndef FM_STREAM_PREFETCH
+#define FM_STREAM_PREFETCH 1024
+#endif
+#define FM_STREAM_LINE 64
+
+/* store one cache line of doubles from t to y with non-temporal stores.
+ * y must be aligned to FM_STREAM_LINE bytes. */
+static inline void fm_stream_store_line(double *y, const double *t)
+{
+#if defined(__AVX512F__)
+    _mm512_stream_pd(y, _mm512_load_pd(t));
+#elif defined(__AVX__)
+    _mm256_stream_pd(y,   _mm256_load_pd(t));
+    _mm256_stream_pd(y+4, _mm256_load_pd(t+4));
+#elif defined(__SSE2__)
+    _mm_stream_pd(y,   _mm_load_pd(t));
+    _mm_stream_pd(y+2, _mm_load_pd(t+2));
+    _mm_stream_pd(y+4, _mm_load_pd(t+4));
+    _mm_stream_pd(y+6, _mm_load_pd(t+6));
+#else
+    int i;
+    for (i = 0; i < 8; ++i) y[i] = t[i];
+#endif
+}
+
+/* non-temporal stores are weakly ordered, so they must be
+ * fenced before the results can be used by another thread. */
+static inline void fm_stream_fence(void)
+{
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+#define FM_BATCH_STREAM_DEF(name,kernel)                                \
+    void name ## _v_stream(const double *x, double *y, size_t n)        \
+    {                                                                   \
+        double t[FM_STREAM_LINE/sizeof(double)]                         \
+            __attribute__ ((aligned(FM_STREAM_LINE)));                  \
+        const size_t nl = FM_STREAM_LINE/sizeof(double);                \
+        size_t i, j;                                                    \
+                                                                        \
+        if (n*sizeof(double) < FM_STREAM_THRESHOLD) {                   \
+            for (i = 0; i < n; ++i) y[i] = kernel(x[i]);                \
+            return;                                                     \
+        }                                                               \
+                                                                        \
+        /* regular stores until the output is cache line aligned */    \
+        for (i = 0; (i < n) && (((uintptr_t) (y+i)) % FM_STREAM_LINE);  \
+             ++i) y[i] = kernel(x[i]);                                  \
+                                                                        \
+        for (; i + nl <= n; i += nl) {                                  \
+            __builtin_prefetch(((const char *) (x+i))                   \
+                               + FM_STREAM_PREFETCH, 0, 0);             \
+            for (j = 0; j < nl; ++j) t[j] = kernel(x[i+j]);             \
+            fm_stream_store_line(y+i, t);                               \
+        }                                                               \
+        fm_stream_fence();                                              \
+                                                                        \
+        for (; i < n; ++i) y[i] = kernel(x[i]);                         \
+    }
+
 /* IEEE 754 single precision floating point data manipulation */
 typedef union 
 {
@@ -71,11 +270,24 @@ typedef union
 #define FM_DOUBLE_MMASK 1048575
 #define FM_DOUBLE_EZERO 1072693248
 
+/* the same masks for the whole 64-bit pattern */
+#define FM_DOUBLE_SIGN64  0x8000000000000000ULL
+#define FM_DOUBLE_EMASK64 0x7ff0000000000000ULL
+#define FM_DOUBLE_MMASK64 0x000fffffffffffffULL
+#define FM_DOUBLE_EZERO64 0x3ff0000000000000ULL
+#define FM_DOUBLE_QNAN64  0x0008000000000000ULL
+#define FM_DOUBLE_NINF64  0xfff0000000000000ULL
+
 /* generate 2**num in floating point by bitshifting */
 #define FM_DOUBLE_INIT_EXP(var,num)                 \
     var.s.i0 = 0;                                     \
     var.s.i1 = (((int) num) + FM_DOUBLE_BIAS) << 20
 
+/* same as above, but with a single 64-bit integer operation,
+ * which the compiler can map to packed integer vector instructions. */
+#define FM_DOUBLE_INIT_EXP64(var,num)                                   \
+    var.u = ((uint64_t) (((int) num) + FM_DOUBLE_BIAS)) << 52
+
 /* single precision constants */
 #define FM_FLOAT_LOG2OFE  1.4426950408889634074f
 #define FM_FLOAT_LOGEOF2  6.9314718055994530942e-1f
@@ -84,6 +296,7 @@ typedef union
 #define FM_FLOAT_LOG10OFE 4.3429448190325182765e-1f
 #define FM_FLOAT_SQRT2    1.41421356237309504880f
 #define FM_FLOAT_SQRTH    0.70710678118654752440f
+#define FM_FLOAT_SQRTH_BITS  0x3f3504f3U
 
 /* double precision constants */
 #define FM_DOUBLE_LOG2OFE  1.4426950408889634074
@@ -93,6 +306,23 @@ typedef union
 #define FM_DOUBLE_LOG10OFE 4.3429448190325182765e-1
 #define FM_DOUBLE_SQRT2    1.41421356237309504880
 #define FM_DOUBLE_SQRTH    0.70710678118654752440
+#define FM_DOUBLE_SQRTH_BITS 0x3fe6a09e667f3bcdULL
+
+/* split constants for the Cody-Waite argument reduction x - k*log(2)
+ * and x - k*log10(2). with a fused multiply-add the product k*hi is
+ * not rounded, so hi can be the full precision value. otherwise hi
+ * needs enough trailing zero bits for k*hi to be exact. */
+#if defined(__FMA__)
+#define FM_DOUBLE_LOGEOF2_HI  6.93147180559945286227e-01
+#define FM_DOUBLE_LOGEOF2_LO  2.31904681384629955842e-17
+#define FM_DOUBLE_LOG10OF2_HI 3.01029995663981198017e-01
+#define FM_DOUBLE_LOG10OF2_LO -2.80372812778517039373e-18
+#else
+#define FM_DOUBLE_LOGEOF2_HI  6.93145751953125e-1
+#define FM_DOUBLE_LOGEOF2_LO  1.42860682030941723212e-6
+#define FM_DOUBLE_LOG10OF2_HI 3.01025390625000000000e-1
+#define FM_DOUBLE_LOG10OF2_LO 4.60503898119521373889e-6
+#endif
 
 #endif /* FM_INTERNAL_H */
 
@@ -88,6 +88,38 @@ static double my_exp(double x)
     return epart.f*x;
 }
 
+/* FMA based variant of my_exp(x).
+ *
+ * the argument is reduced as x - ipart*log(2) with two fused
+ * multiply-adds before converting it to base 2. this avoids the
+ * rounding error of x*log2(e), which grows with the magnitude of x
+ * and dominates the error of erfc(x) for large x.
+ */
+
+static inline double my_exp_fma(double x)
+{
+    double   ipart, fpart, px, qx;
+    udi_t    epart;
+
+    ipart = __builtin_floor(FM_DOUBLE_LOG2OFE*x + 0.5);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_HI, x);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_LO, x);
+    fpart = x*FM_DOUBLE_LOG2OFE;
+    FM_DOUBLE_INIT_EXP64(epart,ipart);
+
+    x = fpart*fpart;
+
+    px = FM_FMA(fm_exp2_p[0], x, fm_exp2_p[1]);
+    qx = x + fm_exp2_q[0];
+    px = FM_FMA(px, x, fm_exp2_p[2]);
+    qx = FM_FMA(qx, x, fm_exp2_q[1]);
+
+    px = px * fpart;
+
+    x = FM_FMA(2.0, px/(qx-px), 1.0);
+    return epart.f*x;
+}
+
 /* Library libcerf:
  *   Compute complex error functions, based on a new implementation of
  *   Faddeeva's w_of_z. Also provide Dawson and Voigt functions.
@@ -560,6 +592,51 @@ static double erfcx_y100(double y100)
 } /* erfcx_y100 */
 
 
+/* latency optimized variant of erfcx_y100().
+ *
+ * the coefficients of the Chebyshev polynomials are read from a table
+ * instead of a switch statement, so there is no indirect branch, and
+ * the polynomials are evaluated with the Estrin scheme, which reduces
+ * the chain of dependent multiply-adds from 6 to 3.
+ */
+
+#include "erfcx_tbl.c"
+
+static double erfcx_y100_lat(double y100)
+{
+    const int i = (int) y100;
+    const double * const c = fm_erfcx_c[i];
+    const double t = 2*y100 - (2*i+1);
+    double t2, t4, a, b, d;
+
+    t2 = t*t;
+    a  = c[1]*t + c[0];
+    b  = c[3]*t + c[2];
+    d  = c[5]*t + c[4];
+    t4 = t2*t2;
+    d  = c[6]*t2 + d;
+    a  = b*t2 + a;
+    return d*t4 + a;
+}
+
+/* same as erfcx_y100_lat(), written with explicit fused multiply-adds */
+static inline double erfcx_y100_fma(double y100)
+{
+    const int i = (int) y100;
+    const double * const c = fm_erfcx_c[i];
+    const double t = 2*y100 - (2*i+1);
+    double t2, t4, a, b, d;
+
+    t2 = t*t;
+    a  = FM_FMA(c[1], t, c[0]);
+    b  = FM_FMA(c[3], t, c[2]);
+    d  = FM_FMA(c[5], t, c[4]);
+    t4 = t2*t2;
+    d  = FM_FMA(c[6], t2, d);
+    a  = FM_FMA(b, t2, a);
+    return FM_FMA(d, t4, a);
+}
+
 /******************************************************************************/
 /*  adapted from library function erfcx                                       */
 /******************************************************************************/
@@ -602,6 +679,102 @@ double fm_erfc(double x)
     else return (x < -6.1) ? 2.0 : 2.0 - erfcx_y100(400/(4-x)) * expm2;
 } /* erfc() */
 
+/* latency optimized variant of fm_erfc() */
+double fm_erfc_lat(double x)
+{
+    const double expm2 = my_exp(-x*x);
+
+    if (x >= 0) return (x > 26.64) ? 0.0 : erfcx_y100_lat(400/(4+x)) * expm2;
+    else return (x < -6.1) ? 2.0 : 2.0 - erfcx_y100_lat(400/(4-x)) * expm2;
+}
+
+/* FMA based variant of fm_erfc().
+ *
+ * x*x is split into a rounded product and its exact rounding error
+ * (with FMA), and exp(-x*x) is corrected by the error term to first
+ * order. the rounding error of x*x is otherwise amplified by x*x in
+ * the result of exp(-x*x).
+ */
+static inline double fm_erfc_fma_inl(double x)
+{
+    const double x2 = x*x;
+    const double x2l = FM_FMA(x, x, -x2);
+    double expm2 = my_exp_fma(-x2);
+
+    expm2 = FM_FMA(-x2l, expm2, expm2);
+
+    if (x >= 0) return (x > 26.64) ? 0.0 : erfcx_y100_fma(400/(4+x)) * expm2;
+    else return (x < -6.1) ? 2.0 : FM_FMA(-erfcx_y100_fma(400/(4-x)), expm2, 2.0);
+}
+
+double fm_erfc_fma(double x)
+{
+    return fm_erfc_fma_inl(x);
+}
+
+/* branch free variant of fm_erfc_fma() for the batch functions.
+ *
+ * erfcx() is evaluated once for |x| and both sides of the branches
+ * are selected from, so that the compiler can vectorize the loop and
+ * load the coefficients with gather instructions. the table index is
+ * clamped, so that no lane can read outside of the table.
+ */
+static inline double fm_erfc_batch_inl(double x)
+{
+    const double ax = __builtin_fabs(x);
+    const double x2 = x*x;
+    const double x2l = FM_FMA(x, x, -x2);
+    const double y100 = 400/(4+ax);
+    double expm2, r, t, t2, t4, a, b, d;
+    const double * const c = &fm_erfcx_c[0][0];
+    int i;
+
+    expm2 = my_exp_fma((x2 > 720.0) ? -720.0 : -x2);
+    expm2 = FM_FMA(-x2l, expm2, expm2);
+
+    i = (int) y100;
+    i = (i < 0) ? 0 : ((i > 100) ? 100 : i);
+    t = 2*y100 - (2*i+1);
+    i *= 8;
+
+    t2 = t*t;
+    a  = FM_FMA(c[i+1], t, c[i+0]);
+    b  = FM_FMA(c[i+3], t, c[i+2]);
+    d  = FM_FMA(c[i+5], t, c[i+4]);
+    t4 = t2*t2;
+    d  = FM_FMA(c[i+6], t2, d);
+    a  = FM_FMA(b, t2, a);
+    r  = FM_FMA(d, t4, a) * expm2;
+
+    if (x >= 0) return (x > 26.64) ? 0.0 : r;
+    else return (x < -6.1) ? 2.0 : 2.0 - r;
+}
+
+/* strided, indexed, masked and accumulating batch versions of erfc(x),
+ * see fm_internal.h */
+FM_BATCH_STRIDED_DEF(fm_erfc,fm_erfc_batch_inl)
+FM_BATCH_IDX_DEF(fm_erfc,fm_erfc_batch_inl)
+FM_BATCH_MASK_DEF(fm_erfc,fm_erfc_batch_inl)
+
+/* same as FM_BATCH_AXPBY_DEF(), but the results are collected in a
+ * buffer on the stack first. the compiler can otherwise not prove,
+ * that the stores to y do not modify the coefficient table, and
+ * does not vectorize the loop. */
+void fm_erfc_axpby(double a, double b, double c,
+                   const double *x, double *y, size_t n)
+{
+    double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN)));
+    size_t i, j, m;
+
+    for (i = 0; i < n; i += m) {
+        m = (n - i < FM_BATCH_BLOCK) ? n - i : FM_BATCH_BLOCK;
+        for (j = 0; j < m; ++j)
+            buf[j] = fm_erfc_batch_inl(FM_FMA(b, x[i+j], c));
+        for (j = 0; j < m; ++j)
+            y[i+j] = FM_FMA(a, buf[j], y[i+j]);
+    }
+}
+
 /* optimizer friendly implementation of exp2f(x).
  *
  * strategy:
@@ -687,7 +860,11 @@ float fm_erfcf(float x)
 
 #if defined(LIBM_ALIAS)
 /* include aliases to the equivalent libm functions for use with LD_PRELOAD. */
+#if defined(USE_FMA_KERNELS)
+double erfc(double x) __attribute__ ((alias("fm_erfc_fma")));
+#else
 double erfc(double x) __attribute__ ((alias("fm_erfc")));
+#endif
 float erfcf(float x) __attribute__ ((alias("fm_erfcf")));
 #endif
 
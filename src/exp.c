@@ -93,6 +93,35 @@ double fm_exp10(double x)
     return fm_exp2(FM_DOUBLE_LOG2OF10*x);
 }
 
+/* FMA based implementation of exp2(x).
+ *
+ * same algorithm as fm_exp2(), but written with explicit fused
+ * multiply-adds, so it does not depend on the compiler contracting
+ * the separate multiplies and adds.
+ */
+
+double fm_exp2_fma(double x)
+{
+    double   ipart, fpart, px, qx;
+    udi_t    epart;
+
+    ipart = __builtin_floor(x+0.5);
+    fpart = x - ipart;
+    FM_DOUBLE_INIT_EXP(epart,ipart);
+
+    x = fpart*fpart;
+
+    px = FM_FMA(fm_exp2_p[0], x, fm_exp2_p[1]);
+    qx = x + fm_exp2_q[0];
+    px = FM_FMA(px, x, fm_exp2_p[2]);
+    qx = FM_FMA(qx, x, fm_exp2_q[1]);
+
+    px = px * fpart;
+
+    x = FM_FMA(2.0, px/(qx-px), 1.0);
+    return epart.f*x;
+}
+
 /* optimizer friendly implementation of exp2f(x).
  *
  * strategy:
@@ -142,16 +171,61 @@ float fm_expf(float x)
     return fm_exp2f(FM_FLOAT_LOG2OFE*x);
 }
 
+/* latency optimized variant of exp2f(x).
+ *
+ * same as fm_exp2f(), but the polynomial is evaluated with
+ * the Estrin scheme, which reduces the length of the chain of
+ * dependent multiply-adds from 6 to 3 at the expense of two
+ * additional multiplications. this is faster where the result
+ * of the previous call is needed for the next (e.g. in scalar
+ * monte carlo moves), while the Horner scheme of fm_exp2f() has
+ * the higher throughput for independent arguments.
+ */
+
+float fm_exp2f_lat(float x)
+{
+    float ipart, fpart, x2, x4, a, b, c;
+    ufi_t epart;
+
+    ipart = __builtin_floorf(x + 0.5f);
+    fpart = x - ipart;
+    FM_FLOAT_INIT_EXP(epart,ipart);
+
+    x2 = fpart*fpart;
+    a  = fm_exp2f_p[5]*fpart + fm_exp2f_p[6];
+    b  = fm_exp2f_p[3]*fpart + fm_exp2f_p[4];
+    c  = fm_exp2f_p[1]*fpart + fm_exp2f_p[2];
+    x4 = x2*x2;
+    c  = fm_exp2f_p[0]*x2 + c;
+    a  = b*x2 + a;
+    x  = c*x4 + a;
+
+    return epart.f*x;
+}
+
+float fm_expf_lat(float x)
+{
+    return fm_exp2f_lat(FM_FLOAT_LOG2OFE*x);
+}
+
 float fm_exp10f(float x)
 {
     return fm_exp2f(FM_FLOAT_LOG2OF10*x);
 }
 
+/* the highest accuracy tiers, see exp_tier.c */
+float fm_exp2f_p23(float x) __attribute__ ((alias("fm_exp2f")));
+double fm_exp2_p52(double x) __attribute__ ((alias("fm_exp2")));
+
 #if defined(LIBM_ALIAS)
 /* include aliases to the equivalent libm functions for use with LD_PRELOAD. */
+#if defined(USE_FMA_KERNELS)
+double exp2(double x) __attribute__ ((alias("fm_exp2_fma")));
+#else
 double exp2(double x) __attribute__ ((alias("fm_exp2")));
 double exp(double x) __attribute__ ((alias("fm_exp")));
 double exp10(double x) __attribute__ ((alias("fm_exp10")));
+#endif
 float exp2f(float x) __attribute__ ((alias("fm_exp2f")));
 float expf(float x) __attribute__ ((alias("fm_expf")));
 float exp10f(float x) __attribute__ ((alias("fm_exp10f")));
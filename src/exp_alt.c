@@ -87,6 +87,38 @@ double fm_exp_alt(double x)
     return epart.f*x;
 }
 
+/* FMA based implementation of exp(x).
+ *
+ * same as fm_exp_alt(), but the argument reduction x - ipart*log(2)
+ * and the polynomials use explicit fused multiply-adds. with FMA,
+ * the high part of log(2) needs no trailing zero bits, which makes
+ * the reduction more accurate for large arguments.
+ */
+
+double fm_exp_fma(double x)
+{
+    double   ipart, xx, px, qx;
+    udi_t    epart;
+
+    ipart  = __builtin_floor(FM_DOUBLE_LOG2OFE*x + 0.5);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_HI, x);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_LO, x);
+    FM_DOUBLE_INIT_EXP(epart,ipart);
+
+    xx = x*x;
+
+    px = FM_FMA(fm_exp_p[0], xx, fm_exp_p[1]);
+    qx = FM_FMA(fm_exp_q[0], xx, fm_exp_q[1]);
+    px = FM_FMA(px, xx, fm_exp_p[2]);
+    qx = FM_FMA(qx, xx, fm_exp_q[2]);
+    px = px*x;
+    qx = FM_FMA(qx, xx, fm_exp_q[3]);
+
+    x = FM_FMA(2.0, px/(qx-px), 1.0);
+
+    return epart.f*x;
+}
+
 /* optimizer friendly implementation of expf(x).
  *
  * strategy:
@@ -129,6 +161,35 @@ float fm_expf_alt(float x)
     return epart.f*px;
 }
 
+/* latency optimized variant of fm_expf_alt().
+ *
+ * same as fm_expf_alt(), but with Estrin evaluation of the
+ * polynomial, which shortens the dependency chain from 7 to 4
+ * multiply-adds.
+ */
+
+float fm_expf_alt_lat(float x)
+{
+    float ipart, x2, x4, a, b, c;
+    ufi_t epart;
+
+    ipart  = __builtin_floorf(FM_FLOAT_LOG2OFE*x + 0.5f);
+    x -= ipart*fm_expf_c1;
+    x -= ipart*fm_expf_c2;
+    FM_FLOAT_INIT_EXP(epart,ipart);
+
+    x2 = x*x;
+    a  = fm_expf_p[4]*x + fm_expf_p[5];
+    b  = fm_expf_p[2]*x + fm_expf_p[3];
+    c  = fm_expf_p[0]*x + fm_expf_p[1];
+    x4 = x2*x2;
+    a  = b*x2 + a;
+    a  = c*x4 + a;
+    a  = a*x2 + (x + 1.0f);
+
+    return epart.f*a;
+}
+
 /* optimizer friendly implementation of exp10(x).
  *
  * strategy:
@@ -183,6 +244,33 @@ double fm_exp10_alt(double x)
     return epart.f*x;
 }
 
+/* FMA based implementation of exp10(x). same strategy as fm_exp_fma(). */
+
+double fm_exp10_fma(double x)
+{
+    double   ipart, xx, px, qx;
+    udi_t    epart;
+
+    ipart  = __builtin_floor(FM_DOUBLE_LOG2OF10*x + 0.5);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOG10OF2_HI, x);
+    x = FM_FMA(-ipart, FM_DOUBLE_LOG10OF2_LO, x);
+    FM_DOUBLE_INIT_EXP(epart,ipart);
+
+    xx = x*x;
+
+    px = FM_FMA(fm_exp10_p[0], xx, fm_exp10_p[1]);
+    qx = FM_FMA(fm_exp10_q[0], xx, fm_exp10_q[1]);
+    px = FM_FMA(px, xx, fm_exp10_p[2]);
+    qx = FM_FMA(qx, xx, fm_exp10_q[2]);
+    px = FM_FMA(px, xx, fm_exp10_p[3]);
+    qx = FM_FMA(qx, xx, fm_exp10_q[3]);
+    px *= x;
+
+    x = FM_FMA(2.0, px/(qx-px), 1.0);
+
+    return epart.f*x;
+}
+
 /* optimizer friendly implementation of exp10f(x).
  *
  * strategy:
@@ -225,6 +313,16 @@ float fm_exp10f_alt(float x)
     return epart.f*px;
 }
 
+#if defined(LIBM_ALIAS) && defined(USE_FMA_KERNELS)
+/* include aliases to the equivalent libm functions for use with LD_PRELOAD. */
+double exp(double x) __attribute__ ((alias("fm_exp_fma")));
+double exp10(double x) __attribute__ ((alias("fm_exp10_fma")));
+#endif
+
+/* the highest accuracy tiers of e**x, see exp_tier.c */
+float fm_expf_p23(float x) __attribute__ ((alias("fm_expf_alt")));
+double fm_exp_p52(double x) __attribute__ ((alias("fm_exp_alt")));
+
 /* 
  * Local Variables:
  * mode: c
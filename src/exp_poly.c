@@ -0,0 +1,100 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* division free versions of 2**x, e**x, and 10**x in double precision.
+ *
+ * the pade' approximations in exp.c and exp_alt.c need a division,
+ * which has a low throughput, specifically for packed vector operands.
+ * the functions here use a minimax polynomial of degree 11 instead,
+ * computed with genpoly, with about the same accuracy (~1 ulp).
+ * there are no tables and no branches, so the batch versions can be
+ * fully vectorized by the compiler.
+ */
+
+/* -ffast-math allows the compiler to contract the two step
+ * Cody-Waite argument reduction (x - k*c1) - k*c2 into x - k*(c1+c2),
+ * which loses the extra precision of the split constant. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "exp_poly_kernel.c"
+
+double fm_exp2_poly(double x)
+{
+    return fm_exp2_poly_inl(x);
+}
+
+double fm_exp_poly(double x)
+{
+    return fm_exp_poly_inl(x);
+}
+
+double fm_exp10_poly(double x)
+{
+    return fm_exp10_poly_inl(x);
+}
+
+FM_BATCH_DEF(double,fm_exp2_poly,fm_exp2_poly_inl)
+FM_BATCH_DEF(double,fm_exp_poly,fm_exp_poly_inl)
+FM_BATCH_DEF(double,fm_exp10_poly,fm_exp10_poly_inl)
+
+/* the batch versions of the default functions use the same kernels,
+ * since they vectorize best. */
+FM_BATCH_DEF(double,fm_exp2,fm_exp2_poly_inl)
+FM_BATCH_DEF(double,fm_exp,fm_exp_poly_inl)
+FM_BATCH_DEF(double,fm_exp10,fm_exp10_poly_inl)
+
+FM_BATCH_STREAM_DEF(fm_exp2,fm_exp2_poly_inl)
+FM_BATCH_STREAM_DEF(fm_exp,fm_exp_poly_inl)
+FM_BATCH_STREAM_DEF(fm_exp10,fm_exp10_poly_inl)
+
+FM_BATCH_STRIDED_DEF(fm_exp,fm_exp_poly_inl)
+FM_BATCH_IDX_DEF(fm_exp,fm_exp_poly_inl)
+FM_BATCH_MASK_DEF(fm_exp,fm_exp_poly_inl)
+
+/* y[i] += a*2**(b*x[i]+c) and y[i] += a*e**(b*x[i]+c). the argument
+ * goes through the same clamping, reduction and NaN test as in the
+ * scalar functions, so that under- and overflow are handled the same
+ * way. */
+FM_BATCH_AXPBY_DEF(fm_exp2,fm_exp2_poly_inl)
+FM_BATCH_AXPBY_DEF(fm_exp,fm_exp_poly_inl)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
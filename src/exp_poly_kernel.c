@@ -0,0 +1,149 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* static inline kernels of the division free 2**x, e**x and 10**x
+ * functions. this file is included by exp_poly.c and omp.c, so that
+ * the batch loops in both can inline them. see exp_poly.c for details.
+ */
+
+/* minimax polynomial for exp2(x) in [-0.5:0.5], degree 11,
+   max rel err 2.087e-16 (52.1 bits) */
+static const double fm_exp2_poly_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 4.43508234012096744419e-10,
+ 7.07410335646657463954e-09,
+ 1.01781994992213688852e-07,
+ 1.32154331012084317637e-06,
+ 1.52527334859352640408e-05,
+ 1.54035304624942470230e-04,
+ 1.33335581467950098702e-03,
+ 9.61812910758835099001e-03,
+ 5.55041086648198900289e-02,
+ 2.40226506959101554495e-01,
+ 6.93147180559945286227e-01,
+ 1.00000000000000000000e+00
+};
+
+/* 2**fpart * 2**ipart for fpart in [-0.5:0.5] and ipart in
+ * [-1100:1100]. 2**ipart is applied in two steps, so that results
+ * below 2**-1022 become subnormal or 0 and results above 2**1024 inf,
+ * instead of wrapping around in the exponent bits. */
+static inline double fm_exp2_poly_kernel(double ipart, double fpart)
+{
+    double x;
+    udi_t e1, e2;
+    int i, h;
+
+    i = (int) ipart;
+    h = i >> 1;
+    FM_DOUBLE_INIT_EXP64(e1,h);
+    FM_DOUBLE_INIT_EXP64(e2,i-h);
+
+    x =           fm_exp2_poly_p[0];
+    x = x*fpart + fm_exp2_poly_p[1];
+    x = x*fpart + fm_exp2_poly_p[2];
+    x = x*fpart + fm_exp2_poly_p[3];
+    x = x*fpart + fm_exp2_poly_p[4];
+    x = x*fpart + fm_exp2_poly_p[5];
+    x = x*fpart + fm_exp2_poly_p[6];
+    x = x*fpart + fm_exp2_poly_p[7];
+    x = x*fpart + fm_exp2_poly_p[8];
+    x = x*fpart + fm_exp2_poly_p[9];
+    x = x*fpart + fm_exp2_poly_p[10];
+    x = x*fpart + fm_exp2_poly_p[11];
+
+    return (x*e1.f)*e2.f;
+}
+
+/* return y, or x if x is NaN. with -ffast-math the compiler assumes
+ * there is no NaN and may turn the clamps below into min/max
+ * instructions, which return either bound for NaN depending on the
+ * operand order, so the scalar and vectorized code would disagree.
+ * the NaN test on the bits is not affected by that and becomes a
+ * compare and blend in the vectorized loops. */
+static inline double fm_exp_poly_nan(double x, double y)
+{
+    udi_t u;
+
+    u.f = x;
+    return ((int64_t) (u.u & ~FM_DOUBLE_SIGN64)
+            > (int64_t) FM_DOUBLE_EMASK64) ? x : y;
+}
+
+/* the arguments are clamped to the range, where the result is not
+ * already 0 or inf, so that infinite arguments do not lead to NaN in
+ * the reduction. NaN is passed through. */
+static inline double fm_exp2_poly_inl(double x)
+{
+    double ipart, c;
+
+    c = (x < -1100.0) ? -1100.0 : x;
+    c = (c > 1100.0) ? 1100.0 : c;
+    ipart = __builtin_floor(c + 0.5);
+    return fm_exp_poly_nan(x, fm_exp2_poly_kernel(ipart, c - ipart));
+}
+
+/* for e**x and 10**x the argument is reduced with a two constant
+ * Cody-Waite scheme to r = x - ipart*log(2) before converting it to
+ * base 2. this keeps the result accurate for large arguments. */
+
+static inline double fm_exp_poly_inl(double x)
+{
+    double ipart, c;
+
+    c = (x < -760.0) ? -760.0 : x;
+    c = (c > 760.0) ? 760.0 : c;
+    ipart = __builtin_floor(FM_DOUBLE_LOG2OFE*c + 0.5);
+    c = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_HI, c);
+    c = FM_FMA(-ipart, FM_DOUBLE_LOGEOF2_LO, c);
+    return fm_exp_poly_nan(x, fm_exp2_poly_kernel(ipart,
+                                                  FM_DOUBLE_LOG2OFE*c));
+}
+
+static inline double fm_exp10_poly_inl(double x)
+{
+    double ipart, c;
+
+    c = (x < -330.0) ? -330.0 : x;
+    c = (c > 330.0) ? 330.0 : c;
+    ipart = __builtin_floor(FM_DOUBLE_LOG2OF10*c + 0.5);
+    c = FM_FMA(-ipart, FM_DOUBLE_LOG10OF2_HI, c);
+    c = FM_FMA(-ipart, FM_DOUBLE_LOG10OF2_LO, c);
+    return fm_exp_poly_nan(x, fm_exp2_poly_kernel(ipart,
+                                                  FM_DOUBLE_LOG2OF10*c));
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,165 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* graded accuracy variants of 2**x and e**x in single and double precision.
+ *
+ * the polynomials are minimax approximations of reduced degree for
+ * the same argument reduction as in exp.c. the coefficients have been
+ * computed with genpoly. the function name suffix is the number of bits
+ * of the mantissa, that are (at least) correct for 2**x. the highest
+ * accuracy tier is an alias to the default implementation in exp.c or
+ * exp_alt.c. see the README for measured errors and timings.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "exp_tier_kernel.c"
+
+float fm_exp2f_p11(float x)
+{
+    float ipart, fpart;
+    ufi_t epart;
+
+    ipart = __builtin_floorf(x + 0.5f);
+    fpart = x - ipart;
+    FM_FLOAT_INIT_EXP(epart,ipart);
+
+    return epart.f*fm_exp2f_p11_kernel(fpart);
+}
+
+float fm_expf_p11(float x)
+{
+    return fm_exp2f_p11(FM_FLOAT_LOG2OFE*x);
+}
+
+float fm_exp2f_p16(float x)
+{
+    float ipart, fpart;
+    ufi_t epart;
+
+    ipart = __builtin_floorf(x + 0.5f);
+    fpart = x - ipart;
+    FM_FLOAT_INIT_EXP(epart,ipart);
+
+    return epart.f*fm_exp2f_p16_kernel(fpart);
+}
+
+float fm_expf_p16(float x)
+{
+    return fm_exp2f_p16(FM_FLOAT_LOG2OFE*x);
+}
+
+/* minimax polynomial for exp2(x) in [-0.5:0.5], degree 6,
+   max rel err 1.856e-09 (29.0 bits) */
+static const double fm_exp2_p24_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 1.53458120028865244774e-04,
+ 1.33999312193406445136e-03,
+ 9.61848895711514377538e-03,
+ 5.55032877696472609630e-02,
+ 2.40226468906340862031e-01,
+ 6.93147205737268068404e-01,
+ 1.00000000055416649047e+00
+};
+
+double fm_exp2_p24(double x)
+{
+    double   ipart, fpart;
+    udi_t    epart;
+
+    ipart = __builtin_floor(x+0.5);
+    fpart = x - ipart;
+    FM_DOUBLE_INIT_EXP(epart,ipart);
+
+    x =           fm_exp2_p24_p[0];
+    x = x*fpart + fm_exp2_p24_p[1];
+    x = x*fpart + fm_exp2_p24_p[2];
+    x = x*fpart + fm_exp2_p24_p[3];
+    x = x*fpart + fm_exp2_p24_p[4];
+    x = x*fpart + fm_exp2_p24_p[5];
+    x = x*fpart + fm_exp2_p24_p[6];
+
+    return epart.f*x;
+}
+
+double fm_exp_p24(double x)
+{
+    return fm_exp2_p24(FM_DOUBLE_LOG2OFE*x);
+}
+
+/* minimax polynomial for exp2(x) in [-0.5:0.5], degree 8,
+   max rel err 7.746e-13 (40.2 bits) */
+static const double fm_exp2_p40_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 1.31758581107547082699e-06,
+ 1.53097374221415643463e-05,
+ 1.54038517487487192558e-04,
+ 1.33334520622480209515e-03,
+ 9.61812854286235238699e-03,
+ 5.55041093934171142488e-02,
+ 2.40226506988803711895e-01,
+ 6.93147180546514141142e-01,
+ 9.99999999999762301250e-01
+};
+
+double fm_exp2_p40(double x)
+{
+    double   ipart, fpart;
+    udi_t    epart;
+
+    ipart = __builtin_floor(x+0.5);
+    fpart = x - ipart;
+    FM_DOUBLE_INIT_EXP(epart,ipart);
+
+    x =           fm_exp2_p40_p[0];
+    x = x*fpart + fm_exp2_p40_p[1];
+    x = x*fpart + fm_exp2_p40_p[2];
+    x = x*fpart + fm_exp2_p40_p[3];
+    x = x*fpart + fm_exp2_p40_p[4];
+    x = x*fpart + fm_exp2_p40_p[5];
+    x = x*fpart + fm_exp2_p40_p[6];
+    x = x*fpart + fm_exp2_p40_p[7];
+    x = x*fpart + fm_exp2_p40_p[8];
+
+    return epart.f*x;
+}
+
+double fm_exp_p40(double x)
+{
+    return fm_exp2_p40(FM_DOUBLE_LOG2OFE*x);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,89 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* static inline kernels of the 11 and 16 bit single precision tiers
+ * of 2**x. this file is included by exp_tier.c and half.c, so that
+ * both use the same coefficients. see exp_tier.c for details.
+ */
+
+/* minimax polynomial for exp2(x) in [-0.5:0.5], degree 3,
+   max rel err 7.486e-05 (13.7 bits) */
+static const float fm_exp2f_p11_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 5.5171668530e-02f,
+ 2.4261112511e-01f,
+ 6.9326096773e-01f,
+ 9.9992805719e-01f
+};
+
+/* 2**fpart for fpart in [-0.5:0.5] */
+static inline float fm_exp2f_p11_kernel(float fpart)
+{
+    float x;
+
+    x =           fm_exp2f_p11_p[0];
+    x = x*fpart + fm_exp2f_p11_p[1];
+    x = x*fpart + fm_exp2f_p11_p[2];
+    x = x*fpart + fm_exp2f_p11_p[3];
+
+    return x;
+}
+
+/* minimax polynomial for exp2(x) in [-0.5:0.5], degree 4,
+   max rel err 2.713e-06 (18.5 bits) */
+static const float fm_exp2f_p16_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 9.5701022074e-03f,
+ 5.5917859077e-02f,
+ 2.4024744332e-01f,
+ 6.9312179089e-01f,
+ 9.9999928474e-01f
+};
+
+/* 2**fpart for fpart in [-0.5:0.5] */
+static inline float fm_exp2f_p16_kernel(float fpart)
+{
+    float x;
+
+    x =           fm_exp2f_p16_p[0];
+    x = x*fpart + fm_exp2f_p16_p[1];
+    x = x*fpart + fm_exp2f_p16_p[2];
+    x = x*fpart + fm_exp2f_p16_p[3];
+    x = x*fpart + fm_exp2f_p16_p[4];
+
+    return x;
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
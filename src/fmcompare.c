@@ -0,0 +1,547 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* compare two result files of the tester written with --output in
+ * json or csv format, e.g. of the installed and of an upgraded version
+ * of the library, and report the changes of the time per element and
+ * of the relative errors for each function and mode.
+ *
+ * the time of each function is the minimum over the repetitions,
+ * which is much less sensitive to interruptions than the mean. the
+ * time of the same library also changes between two runs, since the
+ * clock rate and the load of the machine drift, which the spread within
+ * a run does not see. so the logarithms of the ratios of the times of
+ * all functions are taken as a sample of this drift: their median is
+ * the common change of the speed of the machine, which is removed from
+ * the change of each function, and their median absolute deviation
+ * estimates the noise between the runs. a slowdown is a regression when
+ * the time relative to the common change grows by more than the
+ * threshold and by more than sigma times this noise combined with the
+ * standard error of the means. a common change of more than the
+ * threshold is reported as a regression of all functions, since it
+ * cannot be told from a slower machine. with less than MIN_DRIFT common
+ * functions, e.g. with a narrow --filter, neither is estimated and only
+ * the spread within the runs is taken into account.
+ *
+ * an accuracy change is a regression when the average or maximum
+ * relative error grows by more than the tolerance and by more than
+ * errmin. functions missing from the new results count as regressions
+ * as well.
+ *
+ * the exit status is 0 without regressions, 1 with regressions and 2
+ * when a file cannot be read.
+ *
+ * with --matrix the results of any number of files, e.g. of the
+ * testers of several configurations, are merged into tables of the
+ * time per element, the speedup relative to the first file and the
+ * maximum relative error with a row for each function and mode and a
+ * column for each file. */
+
+#define _GNU_SOURCE 1
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#define MAX_LINE   4096
+#define MAX_FIELD  32
+#define MAX_FILE   64
+#define MIN_DRIFT  8     /* functions needed to estimate the drift */
+
+typedef struct {
+    char name[64];              /* function name */
+    char mode[16];              /* throughput or latency */
+    double ns;                  /* mean time per element in ns */
+    double sd;                  /* standard deviation between repetitions */
+    double ns_min;              /* minimum time per element in ns or -1 */
+    double avgerr;              /* average relative error or -1 */
+    double maxerr;              /* maximum relative error or -1 */
+    int reps;                   /* number of repetitions */
+} record_t;
+
+typedef struct {
+    char arch[64];              /* configuration of the build */
+    char cpu[128];              /* CPU model */
+    record_t *rec;
+    int num, max;
+} result_t;
+
+/* copy at most len-1 characters of s */
+static void copystr(char *buf, const char *s, int len)
+{
+    strncpy(buf, s, len);
+    buf[len-1] = '\0';
+}
+
+/* a numerical value, or -1 for null or empty fields */
+static double numval(const char *s)
+{
+    if ((*s == '\0') || (strcmp(s, "null") == 0)) return -1.0;
+    return atof(s);
+}
+
+/* add the record from the parallel lists of keys and values */
+static void add_record(result_t *res, char **key, char **val, int n)
+{
+    record_t *r;
+    int i;
+
+    if (res->num == res->max) {
+        res->max = res->max ? 2*res->max : 256;
+        res->rec = (record_t *) realloc(res->rec, res->max*sizeof(record_t));
+    }
+    r = res->rec + res->num;
+    memset(r, 0, sizeof(record_t));
+    r->ns = r->sd = r->ns_min = r->avgerr = r->maxerr = -1.0;
+    for (i=0; i < n; ++i) {
+        if (strcmp(key[i], "name") == 0)
+            copystr(r->name, val[i], sizeof(r->name));
+        else if (strcmp(key[i], "mode") == 0)
+            copystr(r->mode, val[i], sizeof(r->mode));
+        else if (strcmp(key[i], "ns") == 0) r->ns = numval(val[i]);
+        else if (strcmp(key[i], "ns_sd") == 0) r->sd = numval(val[i]);
+        else if (strcmp(key[i], "ns_min") == 0) r->ns_min = numval(val[i]);
+        else if (strcmp(key[i], "avgerr") == 0) r->avgerr = numval(val[i]);
+        else if (strcmp(key[i], "maxerr") == 0) r->maxerr = numval(val[i]);
+        else if (strcmp(key[i], "reps") == 0) r->reps = atoi(val[i]);
+    }
+    if ((r->name[0] == '\0') || (r->ns < 0.0)) return;
+    ++res->num;
+}
+
+/* split the "key": value pairs of a line of json output of the tester
+   in place. this is not a general json parser, but relies on the
+   tester writing each record and each header entry on its own line. */
+static int split_json(char *line, char **key, char **val)
+{
+    char *p, *q;
+    int n = 0;
+
+    p = line;
+    while ((n < MAX_FIELD) && (p = strchr(p, '"'))) {
+        key[n] = ++p;
+        if (!(p = strchr(p, '"'))) break;
+        *p++ = '\0';
+        while ((*p == ' ') || (*p == ':')) ++p;
+        if (*p == '"') {
+            /* string value. escapes are kept as they are. */
+            val[n] = q = ++p;
+            while (*p && (*p != '"')) {
+                if ((*p == '\\') && p[1]) *q++ = *p++;
+                *q++ = *p++;
+            }
+            if (*p) ++p;
+            *q = '\0';
+        } else {
+            val[n] = p;
+            while (*p && (*p != ',') && (*p != '}') && (*p != '\n')
+                   && (*p != ' ')) ++p;
+            if (*p) *p++ = '\0';
+        }
+        ++n;
+    }
+    return n;
+}
+
+/* split a line of csv output of the tester in place */
+static int split_csv(char *line, char **field)
+{
+    char *p;
+    int n = 0;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    for (p = line; n < MAX_FIELD; ++p) {
+        field[n++] = p;
+        if (!(p = strchr(p, ','))) break;
+        *p = '\0';
+    }
+    return n;
+}
+
+static int read_result(const char *file, result_t *res)
+{
+    FILE *fp;
+    char line[MAX_LINE], *key[MAX_FIELD], *val[MAX_FIELD], *p;
+    int i, n, ncol, json;
+
+    memset(res, 0, sizeof(result_t));
+    copystr(res->arch, "unknown", sizeof(res->arch));
+    copystr(res->cpu, "unknown", sizeof(res->cpu));
+
+    fp = fopen(file, "r");
+    if (!fp) {
+        fprintf(stderr, "cannot open %s: %s\n", file, strerror(errno));
+        return -1;
+    }
+
+    json = -1;
+    ncol = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        for (p = line; (*p == ' ') || (*p == '\t'); ++p);
+        if (json < 0) {
+            if ((*p == '\n') || (*p == '\0')) continue;
+            json = (*p == '{');
+        }
+
+        if (json) {
+            n = split_json(p, key, val);
+            if ((n == 1) && (strcmp(key[0], "arch") == 0))
+                copystr(res->arch, val[0], sizeof(res->arch));
+            else if ((n == 1) && (strcmp(key[0], "cpu") == 0))
+                copystr(res->cpu, val[0], sizeof(res->cpu));
+            else if ((n > 1) && (strcmp(key[0], "name") == 0))
+                add_record(res, key, val, n);
+        } else if (*p == '#') {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (strncmp(p, "# cpu: ", 7) == 0)
+                copystr(res->cpu, p + 7, sizeof(res->cpu));
+            else if (strncmp(p, "# ARCH=", 7) == 0) {
+                for (p += 7; *p == ' '; ++p);
+                copystr(res->arch, p, sizeof(res->arch));
+            }
+        } else if (ncol == 0) {
+            /* the first line that is not a comment has the column names */
+            ncol = split_csv(p, key);
+            for (i=0; i < ncol; ++i) key[i] = strdup(key[i]);
+        } else {
+            n = split_csv(p, val);
+            add_record(res, key, val, (n < ncol) ? n : ncol);
+        }
+    }
+    fclose(fp);
+    if (!json)
+        for (i=0; i < ncol; ++i) free(key[i]);
+
+    if (res->num == 0) {
+        fprintf(stderr, "no results in %s\n", file);
+        return -1;
+    }
+    return 0;
+}
+
+static const record_t *find_record(const result_t *res, const record_t *r)
+{
+    int i;
+
+    for (i=0; i < res->num; ++i)
+        if ((strcmp(res->rec[i].name, r->name) == 0)
+            && (strcmp(res->rec[i].mode, r->mode) == 0))
+            return res->rec + i;
+    return NULL;
+}
+
+/* the time per element to compare: the minimum over the repetitions,
+   or the mean for results without it */
+static double cmptime(const record_t *r)
+{
+    return (r->ns_min > 0.0) ? r->ns_min : r->ns;
+}
+
+static int cmpdouble(const void *a, const void *b)
+{
+    const double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/* the median of the n values of v, which are sorted in place */
+static double median(double *v, int n)
+{
+    if (n < 1) return 0.0;
+    qsort(v, n, sizeof(double), cmpdouble);
+    return (n & 1) ? v[n/2] : 0.5*(v[n/2-1] + v[n/2]);
+}
+
+/* compare the errors e0 and e1. returns 1 if e1 is worse, -1 if it is
+   better and 0 otherwise or if either is not available. */
+static int errchange(double e0, double e1, double tol, double emin)
+{
+    if ((e0 < 0.0) || (e1 < 0.0)) return 0;
+    if ((e1 > e0*(1.0 + tol)) && (e1 - e0 > emin)) return 1;
+    if ((e0 > e1*(1.0 + tol)) && (e0 - e1 > emin)) return -1;
+    return 0;
+}
+
+/* print a relative error or - if it is not available */
+static void print_err(double e)
+{
+    if (e < 0.0) printf("  %11s", "-");
+    else printf("  %11.4g", e);
+}
+
+/* print the records of all files as tables with a column per file */
+static int print_matrix(int nfile, const char **file)
+{
+    result_t *res;
+    const record_t *r, *c;
+    int i, j, k, t, nrow;
+    const record_t **row;
+    static const char * const title[] = {
+        "time per element in ns",
+        "speedup relative to the first column",
+        "maximum relative error"
+    };
+
+    res = (result_t *) calloc(nfile, sizeof(result_t));
+    nrow = 0;
+    for (i=0; i < nfile; ++i) {
+        if (read_result(file[i], res + i)) return 2;
+        nrow += res[i].num;
+    }
+
+    /* the union of the functions and modes in order of appearance */
+    row = (const record_t **) malloc(nrow*sizeof(record_t *));
+    nrow = 0;
+    for (i=0; i < nfile; ++i) {
+        for (j=0; j < res[i].num; ++j) {
+            r = res[i].rec + j;
+            for (k=0; k < nrow; ++k)
+                if ((strcmp(row[k]->name, r->name) == 0)
+                    && (strcmp(row[k]->mode, r->mode) == 0)) break;
+            if (k == nrow) row[nrow++] = r;
+        }
+    }
+
+    for (i=0; i < nfile; ++i)
+        printf("%-20s %s (%s)\n", res[i].arch, file[i], res[i].cpu);
+
+    for (t=0; t < 3; ++t) {
+        printf("\n%s\n%20s  %-10s", title[t], "function", "mode");
+        for (i=0; i < nfile; ++i) printf("  %15.15s", res[i].arch);
+        putchar('\n');
+        for (k=0; k < nrow; ++k) {
+            printf("%20s  %-10s", row[k]->name, row[k]->mode);
+            c = find_record(res, row[k]);
+            for (i=0; i < nfile; ++i) {
+                r = find_record(res + i, row[k]);
+                if (!r) printf("  %15s", "-");
+                else if (t == 0) printf("  %15.4f", r->ns);
+                else if (t == 1) {
+                    if (c && (r->ns > 0.0)) printf("  %15.2f", c->ns/r->ns);
+                    else printf("  %15s", "-");
+                } else {
+                    if (r->maxerr < 0.0) printf("  %15s", "-");
+                    else printf("  %15.4g", r->maxerr);
+                }
+            }
+            putchar('\n');
+        }
+    }
+
+    for (i=0; i < nfile; ++i) free(res[i].rec);
+    free(res);
+    free(row);
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage %s [<options>] <old results> <new results>\n"
+           "      %s --matrix <results> [<results> ...]\n"
+           "options:\n"
+           "  --threshold <pct>  minimal slowdown in percent (default 10)\n"
+           "  --sigma <num>      minimal slowdown in units of the noise\n"
+           "                     between the runs (default 4)\n"
+           "  --errtol <pct>     tolerated growth of the average and\n"
+           "                     maximum relative error (default 10)\n"
+           "  --errmin <num>     ignored growth of the relative errors\n"
+           "                     (default 1e-16)\n"
+           "  --quiet            only list changed functions\n"
+           "  --matrix           print tables of the time per element,\n"
+           "                     the speedup and the maximum error\n"
+           "                     of all files side by side\n",
+           prog, prog);
+}
+
+/* match the command line option name as "name value" or "name=value".
+   returns the value or NULL. */
+static const char *optval(int argc, char **argv, int *idx, const char *name)
+{
+    const char *arg = argv[*idx];
+    const size_t len = strlen(name);
+
+    if (strncmp(arg, name, len) != 0) return NULL;
+    if (arg[len] == '=') return arg + len + 1;
+    if ((arg[len] == '\0') && (*idx + 1 < argc)) return argv[++(*idx)];
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    result_t res0, res1;
+    const record_t *r0, *r1;
+    const char *file[MAX_FILE], *val;
+    double threshold, sigma, errtol, errmin, diff, se, n0, n1;
+    double *lr, drift, noise, t0, t1;
+    int i, n, nfile, quiet, matrix, slow, err, nslow, nerr, nmiss;
+    char status[64];
+
+    threshold = 10.0;
+    sigma = 4.0;
+    errtol = 10.0;
+    errmin = 1.0e-16;
+    quiet = matrix = nfile = 0;
+    for (i=1; i < argc; ++i) {
+        if ((val = optval(argc, argv, &i, "--threshold"))) {
+            threshold = atof(val);
+        } else if ((val = optval(argc, argv, &i, "--sigma"))) {
+            sigma = atof(val);
+        } else if ((val = optval(argc, argv, &i, "--errtol"))) {
+            errtol = atof(val);
+        } else if ((val = optval(argc, argv, &i, "--errmin"))) {
+            errmin = atof(val);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            quiet = 1;
+        } else if (strcmp(argv[i], "--matrix") == 0) {
+            matrix = 1;
+        } else if ((argv[i][0] != '-') && (nfile < MAX_FILE)) {
+            file[nfile++] = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (matrix && (nfile > 0))
+        return print_matrix(nfile, file);
+    if (matrix || (nfile != 2)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (read_result(file[0], &res0) || read_result(file[1], &res1))
+        return 2;
+
+    printf("old: %s (%s, %s)\nnew: %s (%s, %s)\n", file[0], res0.arch,
+           res0.cpu, file[1], res1.arch, res1.cpu);
+    if (strcmp(res0.arch, res1.arch) || strcmp(res0.cpu, res1.cpu))
+        puts("warning: the results are from different configurations "
+             "or CPUs");
+
+    /* the common change of the speed and the noise between the runs
+       from the log ratios of the times of all functions */
+    lr = (double *) malloc(res0.num*sizeof(double));
+    n = 0;
+    for (i=0; i < res0.num; ++i) {
+        r0 = res0.rec + i;
+        r1 = find_record(&res1, r0);
+        if (r1 && (cmptime(r0) > 0.0) && (cmptime(r1) > 0.0))
+            lr[n++] = log(cmptime(r1)/cmptime(r0));
+    }
+    drift = noise = 0.0;
+    if (n >= MIN_DRIFT) {
+        drift = median(lr, n);
+        for (i=0; i < n; ++i) lr[i] = fabs(lr[i] - drift);
+        /* 1.4826 scales the median absolute deviation to the standard
+           deviation of normally distributed data */
+        noise = 1.4826*median(lr, n);
+        printf("common change %+.1f%%, noise between the runs %.1f%%\n",
+               100.0*expm1(drift), 100.0*noise);
+    } else {
+        puts("too few functions to estimate the noise between the runs");
+    }
+    free(lr);
+
+    printf("%20s  %-10s  %9s  %9s  %7s  %11s  %11s\n", "function", "mode",
+           "old ns", "new ns", "change", "old maxerr", "new maxerr");
+
+    nslow = nerr = nmiss = 0;
+    for (i=0; i < res0.num; ++i) {
+        r0 = res0.rec + i;
+        r1 = find_record(&res1, r0);
+        if (!r1) {
+            printf("%20s  %-10s  %9.4f  %9s  %7s", r0->name, r0->mode,
+                   cmptime(r0), "-", "-");
+            print_err(r0->maxerr);
+            printf("  %11s  missing\n", "-");
+            ++nmiss;
+            continue;
+        }
+
+        /* relative standard error of the difference of the means,
+           combined with the noise between the runs */
+        n0 = (r0->reps > 0) ? r0->reps : 1;
+        n1 = (r1->reps > 0) ? r1->reps : 1;
+        se = sqrt(((r0->sd > 0.0) ? r0->sd*r0->sd/n0 : 0.0)
+                  + ((r1->sd > 0.0) ? r1->sd*r1->sd/n1 : 0.0)) / r0->ns;
+        se = sqrt(se*se + noise*noise);
+        t0 = cmptime(r0);
+        t1 = cmptime(r1);
+        diff = ((t0 > 0.0) && (t1 > 0.0)) ? log(t1/t0) - drift : 0.0;
+        slow = 0;
+        if ((fabs(diff) > log1p(0.01*threshold)) && (fabs(diff) > sigma*se))
+            slow = (diff > 0.0) ? 1 : -1;
+        err = errchange(r0->maxerr, r1->maxerr, 0.01*errtol, errmin);
+        if (err == 0)
+            err = errchange(r0->avgerr, r1->avgerr, 0.01*errtol, errmin);
+
+        status[0] = '\0';
+        if (slow > 0) strcat(status, " slower");
+        if (slow < 0) strcat(status, " faster");
+        if (err > 0) strcat(status, " less accurate");
+        if (err < 0) strcat(status, " more accurate");
+        if ((slow > 0) || (err > 0)) strcat(status, "  <== regression");
+        nslow += (slow > 0);
+        nerr += (err > 0);
+        if (quiet && !status[0]) continue;
+
+        printf("%20s  %-10s  %9.4f  %9.4f  %+6.1f%%", r0->name, r0->mode,
+               t0, t1, 100.0*expm1(diff));
+        print_err(r0->maxerr);
+        print_err(r1->maxerr);
+        printf(" %s\n", status);
+    }
+    for (i=0; i < res1.num; ++i) {
+        r1 = res1.rec + i;
+        if (quiet || find_record(&res0, r1)) continue;
+        printf("%20s  %-10s  %9s  %9.4f  %7s  %11s", r1->name, r1->mode,
+               "-", cmptime(r1), "-", "-");
+        print_err(r1->maxerr);
+        puts("  new");
+    }
+
+    if (drift > log1p(0.01*threshold)) {
+        printf("%20s  %-10s  %9s  %9s  %+6.1f%%  <== regression\n", "all",
+               "-", "-", "-", 100.0*expm1(drift));
+        ++nslow;
+    }
+    printf("%d slower, %d less accurate, %d missing\n", nslow, nerr, nmiss);
+    free(res0.rec);
+    free(res1.rec);
+    return (nslow || nerr || nmiss) ? 1 : 0;
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
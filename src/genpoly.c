@@ -0,0 +1,434 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* build minimax polynomial coefficient tables with the Remez exchange
+ * algorithm in single and double precision.
+ *
+ * usage: genpoly <function> <lo> <hi> <degree> <float|double> [<name>]
+ *
+ * the polynomial p(x) of the given degree minimizes the maximum relative
+ * error to the selected function in the interval [lo:hi]. functions with
+ * a "p1" suffix are approximated as f(x) = x*p(x), i.e. the fitted target
+ * is f(x)/x, which is how the logarithm kernels use them.
+ *
+ * the coefficients are written highest order first, so that they can be
+ * used directly in a Horner scheme like the hand coded kernels, into a
+ * file <name>_tbl.c that has the same format as log_spline_tbl.c.
+ * all internal computations are done in long double precision.
+ * only polynomials are fitted; rational approximations p(x)/q(x) like
+ * the one in log_alt.c are not supported.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+static const char copyright[] =
+"/* \n"
+"   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> \n"
+"   All rights reserved.\n"
+"\n"
+"   Redistribution and use in source and binary forms, with or without\n"
+"   modification, are permitted provided that the following conditions\n"
+"   are met:\n"
+"\n"
+"   * Redistributions of source code must retain the above copyright\n"
+"     notice, this list of conditions and the following disclaimer.\n"
+"   * Redistributions in binary form must reproduce the above copyright\n"
+"     notice, this list of conditions and the following disclaimer in the\n"
+"     documentation and/or other materials provided with the distribution.\n"
+"   * Neither the name of the <organization> nor the\n"
+"     names of its contributors may be used to endorse or promote products\n"
+"     derived from this software without specific prior written permission.\n"
+"\n"
+"THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n"
+"AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n"
+"IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n"
+"ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY\n"
+"DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES\n"
+"(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;\n"
+"LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND\n"
+"ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT\n"
+"(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF\n"
+"THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.\n"
+"*/\n";
+
+/* target functions. the "p1" variants are divided by x. */
+
+static long double f_exp2(long double x)  { return exp2l(x); }
+static long double f_exp(long double x)   { return expl(x); }
+static long double f_exp10(long double x) { return expl(x*2.302585092994045684017991454684364208L); }
+
+static long double f_log2p1(long double x)
+{
+    if (fabsl(x) < 1.0e-10L)
+        return (1.0L - 0.5L*x + x*x/3.0L) * 1.442695040888963407359924681001892137L;
+    return log1pl(x)/x * 1.442695040888963407359924681001892137L;
+}
+
+static long double f_log1p(long double x)
+{
+    if (fabsl(x) < 1.0e-10L) return 1.0L - 0.5L*x + x*x/3.0L;
+    return log1pl(x)/x;
+}
+
+static long double f_log10p1(long double x)
+{
+    if (fabsl(x) < 1.0e-10L)
+        return (1.0L - 0.5L*x + x*x/3.0L) * 0.4342944819032518276511289189166050823L;
+    return log1pl(x)/x * 0.4342944819032518276511289189166050823L;
+}
+
+static const struct {
+    const char *name;
+    long double (*func)(long double);
+} fm_poly_funcs[] = {
+    {"exp2",    f_exp2},
+    {"exp",     f_exp},
+    {"exp10",   f_exp10},
+    {"log2p1",  f_log2p1},
+    {"log1p",   f_log1p},
+    {"log10p1", f_log10p1},
+    {NULL, NULL}
+};
+
+#define FM_REMEZ_GRID  20000
+#define FM_REMEZ_ITER  100
+#define FM_REMEZ_DEGMAX 24
+
+static long double fm_poly_eval(const long double *c, int n, long double x)
+{
+    long double y = c[n];
+    int i;
+
+    for (i=n-1; i >= 0; --i) y = y*x + c[i];
+    return y;
+}
+
+/* relative error of the polynomial in c[] at x */
+static long double fm_poly_err(long double (*f)(long double),
+                               const long double *c, int n, long double x)
+{
+    const long double y = f(x);
+    return (fm_poly_eval(c,n,x) - y)/y;
+}
+
+/* solve the (n+2)x(n+2) linear system with gaussian elimination
+ * and partial pivoting. the solution replaces the right hand side. */
+static int fm_solve(long double *a, long double *b, int n)
+{
+    int i,j,k,p;
+    long double t;
+
+    for (k=0; k < n; ++k) {
+        p = k;
+        for (i=k+1; i < n; ++i)
+            if (fabsl(a[i*n+k]) > fabsl(a[p*n+k])) p = i;
+        if (a[p*n+k] == 0.0L) return -1;
+        if (p != k) {
+            for (j=0; j < n; ++j) {
+                t = a[k*n+j]; a[k*n+j] = a[p*n+j]; a[p*n+j] = t;
+            }
+            t = b[k]; b[k] = b[p]; b[p] = t;
+        }
+        for (i=k+1; i < n; ++i) {
+            t = a[i*n+k]/a[k*n+k];
+            for (j=k; j < n; ++j) a[i*n+j] -= t*a[k*n+j];
+            b[i] -= t*b[k];
+        }
+    }
+    for (k=n-1; k >= 0; --k) {
+        t = b[k];
+        for (j=k+1; j < n; ++j) t -= a[k*n+j]*b[j];
+        b[k] = t/a[k*n+k];
+    }
+    return 0;
+}
+
+/* refine a local extremum of the error function with golden section */
+static long double fm_refine(long double (*f)(long double), const long double *c,
+                             int n, long double a, long double b)
+{
+    const long double g = 0.6180339887498948482045868343656381177L;
+    long double x1,x2,e1,e2;
+    int i;
+
+    x1 = b - g*(b-a);
+    x2 = a + g*(b-a);
+    e1 = fabsl(fm_poly_err(f,c,n,x1));
+    e2 = fabsl(fm_poly_err(f,c,n,x2));
+    for (i=0; i < 80; ++i) {
+        if (e1 > e2) {
+            b = x2; x2 = x1; e2 = e1;
+            x1 = b - g*(b-a);
+            e1 = fabsl(fm_poly_err(f,c,n,x1));
+        } else {
+            a = x1; x1 = x2; e1 = e2;
+            x2 = a + g*(b-a);
+            e2 = fabsl(fm_poly_err(f,c,n,x2));
+        }
+    }
+    return 0.5L*(a+b);
+}
+
+/* Remez exchange algorithm for a polynomial of degree n in [lo:hi].
+ * returns the maximum relative error and the coefficients in c[],
+ * lowest order first. */
+static long double fm_remez(long double (*f)(long double), long double lo,
+                            long double hi, int n, long double *c)
+{
+    const int m = n+2;
+    long double *a, *b, *xr, *grid, *egrid, *xnew;
+    long double cbest[FM_REMEZ_DEGMAX+1];
+    long double emax, elev, ebest;
+    int i,j,k,iter,nseg;
+
+    a = (long double *) malloc(m*m*sizeof(long double));
+    b = (long double *) malloc(m*sizeof(long double));
+    xr = (long double *) malloc(m*sizeof(long double));
+    xnew = (long double *) malloc((FM_REMEZ_GRID+1)*sizeof(long double));
+    grid = (long double *) malloc((FM_REMEZ_GRID+1)*sizeof(long double));
+    egrid = (long double *) malloc((FM_REMEZ_GRID+1)*sizeof(long double));
+
+    /* start from the chebyshev extrema */
+    for (i=0; i < m; ++i)
+        xr[i] = 0.5L*(lo+hi) - 0.5L*(hi-lo)*cosl(3.141592653589793238462643383279502884L*i/(m-1));
+
+    for (i=0; i <= FM_REMEZ_GRID; ++i)
+        grid[i] = 0.5L*(lo+hi) - 0.5L*(hi-lo)
+            * cosl(3.141592653589793238462643383279502884L*i/FM_REMEZ_GRID);
+
+    emax = elev = 0.0L;
+    ebest = HUGE_VALL;
+    for (iter=0; iter < FM_REMEZ_ITER; ++iter) {
+
+        /* solve p(x_i) + (-1)**i * E * f(x_i) = f(x_i) */
+        for (i=0; i < m; ++i) {
+            const long double y = f(xr[i]);
+            long double xp = 1.0L;
+            for (j=0; j <= n; ++j) {
+                a[i*m+j] = xp;
+                xp *= xr[i];
+            }
+            a[i*m+n+1] = ((i & 1) ? -1.0L : 1.0L) * y;
+            b[i] = y;
+        }
+        if (fm_solve(a,b,m)) {
+            fputs("singular matrix in remez iteration\n",stderr);
+            break;
+        }
+        for (j=0; j <= n; ++j) c[j] = b[j];
+        elev = fabsl(b[n+1]);
+
+        /* find the extrema of the error function between sign changes */
+        for (i=0; i <= FM_REMEZ_GRID; ++i)
+            egrid[i] = fm_poly_err(f,c,n,grid[i]);
+
+        nseg = 0;
+        k = 0;
+        for (i=1; i <= FM_REMEZ_GRID+1; ++i) {
+            if ((i > FM_REMEZ_GRID) || ((egrid[i] < 0.0L) != (egrid[k] < 0.0L))) {
+                /* segment [k:i-1] has a constant sign. locate the maximum. */
+                int imax = k;
+                for (j=k; j < i; ++j)
+                    if (fabsl(egrid[j]) > fabsl(egrid[imax])) imax = j;
+                if ((imax > 0) && (imax < FM_REMEZ_GRID))
+                    xnew[nseg] = fm_refine(f,c,n,grid[imax-1],grid[imax+1]);
+                else
+                    xnew[nseg] = grid[imax];
+                ++nseg;
+                k = i;
+            }
+        }
+
+        /* too many alternations: remove the smallest extremum and merge
+           the then adjacent extrema of the same sign, keeping the larger */
+        while (nseg > m) {
+            int imin = 0;
+            for (j=1; j < nseg; ++j)
+                if (fabsl(fm_poly_err(f,c,n,xnew[j]))
+                    < fabsl(fm_poly_err(f,c,n,xnew[imin]))) imin = j;
+            memmove(xnew+imin,xnew+imin+1,(nseg-imin-1)*sizeof(long double));
+            --nseg;
+            if ((imin > 0) && (imin < nseg)) {
+                const long double e1 = fm_poly_err(f,c,n,xnew[imin-1]);
+                const long double e2 = fm_poly_err(f,c,n,xnew[imin]);
+                if ((e1 < 0.0L) == (e2 < 0.0L)) {
+                    if (fabsl(e1) < fabsl(e2)) xnew[imin-1] = xnew[imin];
+                    memmove(xnew+imin,xnew+imin+1,
+                            (nseg-imin-1)*sizeof(long double));
+                    --nseg;
+                }
+            }
+        }
+
+        emax = 0.0L;
+        for (i=0; i <= FM_REMEZ_GRID; ++i)
+            if (fabsl(egrid[i]) > emax) emax = fabsl(egrid[i]);
+
+        /* close to long double resolution the iteration may diverge.
+           keep the best set of coefficients. */
+        if (emax < ebest) {
+            ebest = emax;
+            for (j=0; j <= n; ++j) cbest[j] = c[j];
+        }
+
+        if (nseg < m) break;
+        for (i=0; i < m; ++i) xr[i] = xnew[i];
+        if ((emax - elev) < 1.0e-6L*elev) break;
+    }
+
+    for (j=0; j <= n; ++j) c[j] = cbest[j];
+
+    free(a);
+    free(b);
+    free(xr);
+    free(xnew);
+    free(grid);
+    free(egrid);
+    return ebest;
+}
+
+/* maximum relative error with the coefficients rounded to the
+ * target precision and a horner scheme evaluated in that precision */
+static long double fm_check(long double (*f)(long double), long double lo,
+                            long double hi, int n, const long double *c,
+                            int dp)
+{
+    long double x, y, emax = 0.0L;
+    int i,j;
+
+    for (i=0; i <= 100*FM_REMEZ_GRID; ++i) {
+        x = lo + (hi-lo)*i/(100.0L*FM_REMEZ_GRID);
+        if (dp) {
+            double p = (double) c[n];
+            for (j=n-1; j >= 0; --j) p = p*(double)x + (double) c[j];
+            y = (long double) p;
+        } else {
+            float p = (float) c[n];
+            for (j=n-1; j >= 0; --j) p = p*(float)x + (float) c[j];
+            y = (long double) p;
+        }
+        y = fabsl((y - f(x))/f(x));
+        if (y > emax) emax = y;
+    }
+    return emax;
+}
+
+int main(int argc, char **argv)
+{
+    long double c[FM_REMEZ_DEGMAX+1];
+    long double (*f)(long double) = NULL;
+    long double lo, hi, err, chk;
+    char name[256], fname[280];
+    int i, n, dp;
+    FILE *fp;
+
+    if (argc < 6) {
+        printf("usage %s <function> <lo> <hi> <degree> <float|double> [<name>]\n"
+               "functions:",argv[0]);
+        for (i=0; fm_poly_funcs[i].name; ++i)
+            printf(" %s", fm_poly_funcs[i].name);
+        puts("");
+        return -1;
+    }
+
+    for (i=0; fm_poly_funcs[i].name; ++i)
+        if (strcmp(argv[1],fm_poly_funcs[i].name) == 0)
+            f = fm_poly_funcs[i].func;
+    if (f == NULL) {
+        printf("unknown function %s\n",argv[1]);
+        return -1;
+    }
+
+    lo = strtold(argv[2],NULL);
+    hi = strtold(argv[3],NULL);
+    n  = atoi(argv[4]);
+    dp = (strcmp(argv[5],"double") == 0);
+    if (!dp && (strcmp(argv[5],"float") != 0)) {
+        printf("unknown precision %s, must be float or double\n",argv[5]);
+        return -1;
+    }
+    if ((n < 1) || (n > FM_REMEZ_DEGMAX) || !(lo < hi)) {
+        puts("invalid interval or degree");
+        return -1;
+    }
+
+    if (argc > 6)
+        snprintf(name,sizeof(name),"%s",argv[6]);
+    else
+        snprintf(name,sizeof(name),"fm_%s%s_%d",argv[1],dp ? "" : "f",n);
+
+    err = fm_remez(f,lo,hi,n,c);
+    chk = fm_check(f,lo,hi,n,c,dp);
+
+    printf("minimax polynomial for %s(x) in [%Lg:%Lg] with degree %d. "
+           "max rel err=%.4Lg (%.1Lf bits)  in %s=%.4Lg\n",
+           argv[1], lo, hi, n, err, -log2l(err), dp ? "double" : "float", chk);
+
+    snprintf(fname,sizeof(fname),"%s_tbl.c",name);
+    fp = fopen(fname,"w");
+    if (fp == NULL) {
+        printf("cannot open %s for writing: %s\n",fname,strerror(errno));
+        return -1;
+    }
+    fputs(copyright,fp);
+    fprintf(fp,"\n/* minimax polynomial for %s(x) in [%Lg:%Lg], degree %d,\n"
+            "   max rel err %.4Lg (%.1Lf bits) */\n",
+            argv[1], lo, hi, n, chk, -log2l(chk));
+    fprintf(fp,"static const %s %s_p[] "
+            "__attribute__ ((aligned(_FM_ALIGN))) = {\n",
+            dp ? "double" : "float", name);
+    for (i=n; i >= 0; --i) {
+        if (dp)
+            fprintf(fp,"% 025.20e%s\n", (double) c[i], i ? "," : "");
+        else
+            fprintf(fp,"% 015.10ef%s\n", (float) c[i], i ? "," : "");
+    }
+    fprintf(fp,"};\n");
+    fclose(fp);
+
+    return 0;
+}
+
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make"
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -259,10 +259,116 @@ static void fm_init_logf_spl()
     free(fm_logf_q2);
 }
 
+/* build compact 8-bit table for log() in double precision.
+ *
+ * the argument is reduced with the offset FM_LOG_COMPACT_OFF to
+ * [0.6875:1.375[, and the top 8 mantissa bits of the difference select
+ * a cell. each cell stores 1/c for the center c of the cell and log(c),
+ * so that log(x) = log(c) + log1p((x-c)/c). the two cells next to 1.0
+ * use c = 1.0, so that there is no cancellation for x close to 1. */
+#define FM_LOG_COMPACT_BITS 8
+#define FM_LOG_COMPACT_OFF  0x3fe6000000000000ULL
+
+static void fm_init_log_compact()
+{
+    udi_t val;
+    long double c;
+    double invc, logc;
+    int i, max;
+
+    FILE *fp;
+
+    max = 1 << FM_LOG_COMPACT_BITS;
+
+    printf("init compact table for log() with %d bits. mem=%.3f kB\n",
+           FM_LOG_COMPACT_BITS, 2*max*sizeof(double)/1024.0);
+
+    fp = fopen("log_compact_tbl.c","w");
+    fputs(copyright,fp);
+
+    fprintf(fp,"\n#define FM_LOG_COMPACT_BITS %d\n",FM_LOG_COMPACT_BITS);
+    fprintf(fp,"#define FM_LOG_COMPACT_OFF  0x%016llxULL\n",
+            (unsigned long long) FM_LOG_COMPACT_OFF);
+    fprintf(fp,"/* pairs of 1/c, log(c) */\n");
+    fprintf(fp,"static const double fm_log_compact_tbl[] "
+            "__attribute__ ((aligned(64))) = {\n");
+    for (i=0; i < max; ++i) {
+        /* center of the cell. cell max*5/8 starts at 1.0 */
+        val.u = FM_LOG_COMPACT_OFF
+            + ((2*(uint64_t) i + 1) << (51 - FM_LOG_COMPACT_BITS));
+        c = val.f;
+        invc = (double) (1.0L/c);
+        logc = (double) logl(c);
+        if ((i == (max*5)/8 - 1) || (i == (max*5)/8)) {
+            invc = 1.0;
+            logc = 0.0;
+        }
+        fprintf(fp,"% 025.20e, % 025.20e%s\n", invc, logc,
+                (i < max-1) ? "," : "");
+    }
+    fprintf(fp,"};\n");
+    fclose(fp);
+}
+
+/* build table for the accurate log() in double precision.
+ *
+ * uses the same cells as the compact table, but log(c) is stored as
+ * the sum of two doubles. the leading part is rounded to a multiple of
+ * 2**-43, so that adding it to ipart*log(2) with a 32-bit log(2) is
+ * exact for any exponent. the cells within 2**-6 of 1.0 use c = 1.0. */
+#define FM_LOG_ACCURATE_BITS 8
+#define FM_LOG_ACCURATE_OFF  0x3fe6000000000000ULL
+
+static void fm_init_log_accurate()
+{
+    udi_t val;
+    long double c, logc;
+    double invc, logc_hi, logc_lo;
+    int i, max;
+
+    FILE *fp;
+
+    max = 1 << FM_LOG_ACCURATE_BITS;
+
+    printf("init accurate table for log() with %d bits. mem=%.3f kB\n",
+           FM_LOG_ACCURATE_BITS, 3*max*sizeof(double)/1024.0);
+
+    fp = fopen("log_accurate_tbl.c","w");
+    fputs(copyright,fp);
+
+    fprintf(fp,"\n#define FM_LOG_ACCURATE_BITS %d\n",FM_LOG_ACCURATE_BITS);
+    fprintf(fp,"#define FM_LOG_ACCURATE_OFF  0x%016llxULL\n",
+            (unsigned long long) FM_LOG_ACCURATE_OFF);
+    fprintf(fp,"/* triples of 1/c, log(c) leading part, log(c) trailing part */\n");
+    fprintf(fp,"static const double fm_log_accurate_tbl[] "
+            "__attribute__ ((aligned(64))) = {\n");
+    for (i=0; i < max; ++i) {
+        val.u = FM_LOG_ACCURATE_OFF
+            + ((2*(uint64_t) i + 1) << (51 - FM_LOG_ACCURATE_BITS));
+        c = val.f;
+        invc = (double) (1.0L/c);
+        logc = logl(c);
+        logc_hi = (double) (rintl(ldexpl(logc,43)) / ldexpl(1.0L,43));
+        logc_lo = (double) (logc - logc_hi);
+        /* 8 cells of width 2**-9 below 1.0 and 4 of width 2**-8 above */
+        if ((i >= (max*5)/8 - 8) && (i < (max*5)/8 + 4)) {
+            invc = 1.0;
+            logc_hi = 0.0;
+            logc_lo = 0.0;
+        }
+        fprintf(fp,"% 025.20e, % 025.20e, % 025.20e%s\n",
+                invc, logc_hi, logc_lo, (i < max-1) ? "," : "");
+    }
+    fprintf(fp,"};\n");
+    fclose(fp);
+}
+
 int main(int argc, char **argv)
 {
     fm_init_log_spl();
     fm_init_logf_spl();
+    fm_init_log_compact();
+    fm_init_log_accurate();
 
     return 0;
 }
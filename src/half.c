@@ -0,0 +1,359 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* batch versions of e**x, log(x), and the logistic function
+ * 1/(1+e**-x) for arrays of half precision (IEEE 754 binary16)
+ * and bfloat16 numbers.
+ *
+ * strategy:
+ *
+ * the arrays are processed in blocks of FM_HALF_BLOCK elements, which
+ * are converted to single precision into a small buffer on the stack,
+ * evaluated there, and converted back. the conversions use the F16C
+ * and AVX-512 BF16 instructions, when compiled for them, and integer
+ * bit manipulation otherwise. half precision has only an 11 bit
+ * mantissa (bfloat16 8 bits), so the kernels use the reduced degree
+ * polynomials of the 11 and 16 bit tiers, which are shared with
+ * exp_tier.c and log_tier.c through exp_tier_kernel.c and
+ * log_tier_kernel.c. the log kernels do not
+ * use the spline table of fm_logf(), since gathers from the table
+ * would not vectorize well for blocks this small.
+ *
+ * like the other kernels, log() does not handle zero, negative,
+ * or non-finite arguments. e**x saturates to +inf and 0.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#if defined(__F16C__) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+
+#include "exp_tier_kernel.c"
+#include "log_tier_kernel.c"
+
+#define FM_HALF_BLOCK 16
+
+/* e**x with the exponent clamped to [-160:128], where the result is
+ * already 0 or +inf. 2**ipart is applied in two steps: down to 2**-125
+ * by adding to the exponent bits of the polynomial, which stays normal,
+ * and the rest by a multiplication, so that small results (which
+ * bfloat16 can represent) become subnormal or 0. two multiplications
+ * would not do, since -ffast-math may combine the two factors first. */
+static inline void fm_half_exp2_prep(float x, float *fpart,
+                                     int32_t *ebits, ufi_t *scale)
+{
+    float ipart, k;
+
+    x *= FM_FLOAT_LOG2OFE;
+    x = (x < -160.0f) ? -160.0f : x;
+    x = (x > 128.0f) ? 128.0f : x;
+    ipart = __builtin_floorf(x + 0.5f);
+    *fpart = x - ipart;
+    k = (ipart < -125.0f) ? -125.0f : ipart;
+    *ebits = ((int32_t) k) << FM_FLOAT_MBITS;
+    FM_FLOAT_INIT_EXP((*scale),(ipart-k));
+}
+
+static inline float fm_exp_p16_inl(float x)
+{
+    float fpart;
+    int32_t ebits;
+    ufi_t scale, y;
+
+    fm_half_exp2_prep(x, &fpart, &ebits, &scale);
+
+    y.f = fm_exp2f_p16_kernel(fpart);
+    y.i += ebits;
+
+    return y.f*scale.f;
+}
+
+static inline float fm_exp_p11_inl(float x)
+{
+    float fpart;
+    int32_t ebits;
+    ufi_t scale, y;
+
+    fm_half_exp2_prep(x, &fpart, &ebits, &scale);
+
+    y.f = fm_exp2f_p11_kernel(fpart);
+    y.i += ebits;
+
+    return y.f*scale.f;
+}
+
+/* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent, see log_tier.c.
+ * subnormal arguments (only possible for bfloat16) are normalized first. */
+static inline float fm_half_log_prep(float x, float *ipart)
+{
+    ufi_t val;
+    uint32_t tmp;
+    int sub;
+
+    val.f = x;
+    sub = (val.u < (1U << FM_FLOAT_MBITS));
+    val.f = sub ? x*8388608.0f : x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    *ipart = (float) (((int32_t) tmp) >> FM_FLOAT_MBITS);
+    *ipart -= sub ? (float) FM_FLOAT_MBITS : 0.0f;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    return val.f - 1.0f;
+}
+
+static inline float fm_log_p16_inl(float x)
+{
+    float ipart;
+
+    x = fm_half_log_prep(x, &ipart);
+    return ipart*FM_FLOAT_LOGEOF2 + x*fm_logf_p16_kernel(x);
+}
+
+static inline float fm_log_p11_inl(float x)
+{
+    float ipart;
+
+    x = fm_half_log_prep(x, &ipart);
+    return ipart*FM_FLOAT_LOGEOF2 + x*fm_logf_p11_kernel(x);
+}
+
+/* 1/(1+e**-x) computed from t = e**-|x| <= 1, so that the denominator
+ * cannot overflow, and as t/(1+t) for negative x. */
+static inline float fm_sigmoid_p16_inl(float x)
+{
+    float t, r;
+
+    t = fm_exp_p16_inl(-__builtin_fabsf(x));
+    r = 1.0f/(1.0f + t);
+    return (x < 0.0f) ? t*r : r;
+}
+
+static inline float fm_sigmoid_p11_inl(float x)
+{
+    float t, r;
+
+    t = fm_exp_p11_inl(-__builtin_fabsf(x));
+    r = 1.0f/(1.0f + t);
+    return (x < 0.0f) ? t*r : r;
+}
+
+/* conversion of a single half precision number from and to single
+ * precision with round to nearest even. the latter is based on
+ * the public domain code by Fabian Giesen. */
+static inline float fm_f16_to_float(uint16_t h)
+{
+    ufi_t v;
+    const uint32_t e = (h >> 10) & 0x1f;
+    const uint32_t m = h & 0x3ff;
+
+    if (e == 0x1f) {            /* inf or nan */
+        v.u = 0x7f800000U | (m << 13);
+    } else if (e == 0) {        /* zero or subnormal */
+        v.f = ((float) m) * 5.9604644775390625e-8f;
+    } else {
+        v.u = ((e + (127 - 15)) << 23) | (m << 13);
+    }
+    v.u |= ((uint32_t) (h & 0x8000)) << 16;
+    return v.f;
+}
+
+static inline uint16_t fm_float_to_f16(float f)
+{
+    ufi_t v, magic;
+    uint32_t sign, odd;
+    uint16_t h;
+
+    v.f = f;
+    sign = v.u & 0x80000000U;
+    v.u ^= sign;
+
+    if (v.u >= ((127 + 16) << 23)) {            /* inf or nan */
+        h = (v.u > 0x7f800000U) ? 0x7e00 : 0x7c00;
+    } else if (v.u < ((127 - 14) << 23)) {      /* subnormal or zero */
+        /* align the mantissa bits with a float addition */
+        magic.u = (127 - 1) << 23;
+        v.f += magic.f;
+        h = (uint16_t) (v.u - magic.u);
+    } else {
+        odd = (v.u >> 13) & 1;
+        v.u += ((uint32_t) (15 - 127) << 23) + 0xfff + odd;
+        h = (uint16_t) (v.u >> 13);
+    }
+    return h | (uint16_t) (sign >> 16);
+}
+
+/* bfloat16 is the upper half of a single precision number */
+static inline float fm_bf16_to_float(uint16_t h)
+{
+    ufi_t v;
+
+    v.u = ((uint32_t) h) << 16;
+    return v.f;
+}
+
+static inline uint16_t fm_float_to_bf16(float f)
+{
+    ufi_t v;
+
+    v.f = f;
+    if ((v.u & 0x7fffffffU) > 0x7f800000U)      /* keep nan a quiet nan */
+        return (uint16_t) ((v.u >> 16) | 0x40);
+    v.u += 0x7fff + ((v.u >> 16) & 1);
+    return (uint16_t) (v.u >> 16);
+}
+
+/* convert a block of m <= FM_HALF_BLOCK elements. unused elements of a
+ * partial block are set to 1.0, which is a valid argument for all
+ * kernels. */
+static inline void fm_f16_load(const uint16_t *x, float *t, int m)
+{
+    int i;
+
+#if defined(__F16C__)
+    if (m == FM_HALF_BLOCK) {
+        _mm256_store_ps(t, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) x)));
+        _mm256_store_ps(t+8, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (x+8))));
+        return;
+    }
+#endif
+    for (i = 0; i < m; ++i) t[i] = fm_f16_to_float(x[i]);
+    for (; i < FM_HALF_BLOCK; ++i) t[i] = 1.0f;
+}
+
+static inline void fm_f16_store(const float *t, uint16_t *y, int m)
+{
+    int i;
+
+#if defined(__F16C__)
+    if (m == FM_HALF_BLOCK) {
+        _mm_storeu_si128((__m128i *) y, _mm256_cvtps_ph(_mm256_load_ps(t), _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128((__m128i *) (y+8), _mm256_cvtps_ph(_mm256_load_ps(t+8), _MM_FROUND_TO_NEAREST_INT));
+        return;
+    }
+#endif
+    for (i = 0; i < m; ++i) y[i] = fm_float_to_f16(t[i]);
+}
+
+static inline void fm_bf16_load(const uint16_t *x, float *t, int m)
+{
+    int i;
+
+#if defined(__AVX512BF16__)
+    if (m == FM_HALF_BLOCK) {
+        __m512i v = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *) x));
+        _mm512_store_si512((__m512i *) t, _mm512_slli_epi32(v, 16));
+        return;
+    }
+#endif
+    for (i = 0; i < m; ++i) t[i] = fm_bf16_to_float(x[i]);
+    for (; i < FM_HALF_BLOCK; ++i) t[i] = 1.0f;
+}
+
+static inline void fm_bf16_store(const float *t, uint16_t *y, int m)
+{
+    int i;
+
+#if defined(__AVX512BF16__)
+    if (m == FM_HALF_BLOCK) {
+        __m256bh v = _mm512_cvtneps_pbh(_mm512_load_ps(t));
+        _mm256_storeu_si256((__m256i *) y, (__m256i) v);
+        return;
+    }
+#endif
+    for (i = 0; i < m; ++i) y[i] = fm_float_to_bf16(t[i]);
+}
+
+/* generate a batch function for a half precision format from its
+ * conversion functions and a single precision kernel. the inner loop
+ * has a fixed trip count, so the compiler can fully vectorize it. */
+#define FM_HALF_BATCH_DEF(name,fmt,kernel)                              \
+    void name(const unsigned short *x, unsigned short *y, size_t n)     \
+    {                                                                   \
+        float t[FM_HALF_BLOCK] __attribute__ ((aligned(64)));           \
+        size_t i, j, m;                                                 \
+                                                                        \
+        for (i = 0; i < n; i += FM_HALF_BLOCK) {                        \
+            m = (n - i < FM_HALF_BLOCK) ? (n - i) : FM_HALF_BLOCK;      \
+            fm_ ## fmt ## _load(x+i, t, m);                             \
+            for (j = 0; j < FM_HALF_BLOCK; ++j)                         \
+                t[j] = kernel(t[j]);                                    \
+            fm_ ## fmt ## _store(t, y+i, m);                            \
+        }                                                               \
+    }
+
+FM_HALF_BATCH_DEF(fm_exp_f16_v,f16,fm_exp_p16_inl)
+FM_HALF_BATCH_DEF(fm_log_f16_v,f16,fm_log_p16_inl)
+FM_HALF_BATCH_DEF(fm_sigmoid_f16_v,f16,fm_sigmoid_p16_inl)
+
+FM_HALF_BATCH_DEF(fm_exp_bf16_v,bf16,fm_exp_p11_inl)
+FM_HALF_BATCH_DEF(fm_log_bf16_v,bf16,fm_log_p11_inl)
+FM_HALF_BATCH_DEF(fm_sigmoid_bf16_v,bf16,fm_sigmoid_p11_inl)
+
+/* conversion functions */
+#define FM_HALF_TO_FLOAT_DEF(name,fmt)                                  \
+    void name(const unsigned short *x, float *y, size_t n)              \
+    {                                                                   \
+        float t[FM_HALF_BLOCK] __attribute__ ((aligned(64)));           \
+        size_t i, j, m;                                                 \
+                                                                        \
+        for (i = 0; i < n; i += FM_HALF_BLOCK) {                        \
+            m = (n - i < FM_HALF_BLOCK) ? (n - i) : FM_HALF_BLOCK;      \
+            fm_ ## fmt ## _load(x+i, t, m);                             \
+            for (j = 0; j < m; ++j) y[i+j] = t[j];                      \
+        }                                                               \
+    }
+
+#define FM_FLOAT_TO_HALF_DEF(name,fmt)                                  \
+    void name(const float *x, unsigned short *y, size_t n)              \
+    {                                                                   \
+        float t[FM_HALF_BLOCK] __attribute__ ((aligned(64)));           \
+        size_t i, j, m;                                                 \
+                                                                        \
+        for (i = 0; i < n; i += FM_HALF_BLOCK) {                        \
+            m = (n - i < FM_HALF_BLOCK) ? (n - i) : FM_HALF_BLOCK;      \
+            for (j = 0; j < m; ++j) t[j] = x[i+j];                      \
+            fm_ ## fmt ## _store(t, y+i, m);                            \
+        }                                                               \
+    }
+
+FM_HALF_TO_FLOAT_DEF(fm_f16_to_float_v,f16)
+FM_FLOAT_TO_HALF_DEF(fm_float_to_f16_v,f16)
+FM_HALF_TO_FLOAT_DEF(fm_bf16_to_float_v,bf16)
+FM_FLOAT_TO_HALF_DEF(fm_float_to_bf16_v,bf16)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
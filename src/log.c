@@ -171,6 +171,73 @@ double fm_log10(double x)
     return ((double) ipart)*FM_DOUBLE_LOG10OF2 + (y * FM_DOUBLE_LOG10OFE);
 }
 
+/* FMA based implementations of log2(x), log(x) and log10(x).
+ *
+ * same spline strategy as above, but the spline evaluation and the
+ * final combination with the exponent use explicit fused multiply-adds,
+ * which saves instructions and a rounding step per operation.
+ */
+
+static inline double fm_log_spline_fma(double x, int32_t *ipart)
+{
+    udi_t val;
+    double a,b,y;
+    int32_t hx;
+
+    val.f = x;
+    hx = val.s.i1;
+    
+    /* extract exponent and subtract bias */
+    *ipart = (((hx & FM_DOUBLE_EMASK) >> FM_DOUBLE_MBITS) - FM_DOUBLE_BIAS);
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_DOUBLE_MMASK;
+    val.s.i1 = hx | FM_DOUBLE_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINE_SHIFT;
+
+    /* compute x value matching table index */
+    val.s.i0 = 0;
+    val.s.i1 = FM_DOUBLE_EZERO | (hx << FM_SPLINE_SHIFT);
+    b = (x - val.f) * fm_log_dinv;
+    a = 1.0 - b;
+
+    /* evaluate spline */
+    y = FM_FMA(a, fm_log_q1[hx], b * fm_log_q1[hx+1]);
+    a = FM_FMA(a*a, a, -a) * fm_log_q2[hx];
+    b = FM_FMA(b*b, b, -b) * fm_log_q2[hx+1];
+    return FM_FMA(a + b, fm_log_dsq6, y);
+}
+
+double fm_log2_fma(double x) 
+{
+    double y;
+    int32_t ipart;
+
+    y = fm_log_spline_fma(x, &ipart);
+    return FM_FMA(y, FM_DOUBLE_LOG2OFE, (double) ipart);
+}
+
+double fm_log_fma(double x) 
+{
+    double y;
+    int32_t ipart;
+
+    y = fm_log_spline_fma(x, &ipart);
+    return FM_FMA((double) ipart, FM_DOUBLE_LOGEOF2, y);
+}
+
+double fm_log10_fma(double x) 
+{
+    double y;
+    int32_t ipart;
+
+    y = fm_log_spline_fma(x, &ipart);
+    return FM_FMA((double) ipart, FM_DOUBLE_LOG10OF2, y * FM_DOUBLE_LOG10OFE);
+}
+
 
 /* optimizer friendly implementation of log2f(x).
  *
@@ -305,8 +372,332 @@ float fm_log10f(float x)
     return ((float)ipart)*FM_FLOAT_LOG10OF2 + y*FM_FLOAT_LOG10OFE;
 }
 
+/* IEEE-754 conforming variants of the spline based logarithms.
+ *
+ * strategy:
+ *
+ * subnormal arguments are renormalized with integer math, by turning
+ * the mantissa into a normal number 1.m and subtracting 1.0, which is
+ * exact and does not depend on the FTZ/DAZ state of the FPU.
+ * after the regular spline table evaluation, the special cases are
+ * patched up on the integer representation with selects that the
+ * compiler can turn into blends or conditional moves:
+ *
+ * log(+-0) = -inf, log(x < 0) = NaN, log(+inf) = +inf, log(NaN) = NaN
+ *
+ * the tests have to be done on the bit pattern, since -ffast-math
+ * allows the compiler to assume that there are no infs and NaNs.
+ */
+
+/* replace a subnormal argument by 1.m - 1.0 and return the
+ * exponent correction that has to be added to the result. */
+static inline int32_t fm_log_renorm(udi_t *val)
+{
+    udi_t sub;
+    int issub;
+
+    issub = (val->u & FM_DOUBLE_EMASK64) == 0;
+    sub.u = (val->u & FM_DOUBLE_MMASK64) | FM_DOUBLE_EZERO64;
+    sub.f -= 1.0;
+    val->u = issub ? sub.u : val->u;
+    return issub ? -(FM_DOUBLE_BIAS-1) : 0;
+}
+
+/* patch up the result of a log for zero, negative, inf and NaN input */
+static inline double fm_log_special(uint64_t ux, double y)
+{
+    udi_t res;
+
+    res.f = y;
+    /* +inf -> +inf, NaN -> quiet NaN */
+    res.u = (ux >= FM_DOUBLE_EMASK64)
+        ? ((ux > FM_DOUBLE_EMASK64) ? (ux | FM_DOUBLE_QNAN64) : ux) : res.u;
+    /* negative numbers (and negative NaNs) -> quiet NaN */
+    res.u = (ux > FM_DOUBLE_SIGN64)
+        ? (FM_DOUBLE_EMASK64 | FM_DOUBLE_QNAN64 | (ux & FM_DOUBLE_MMASK64))
+        : res.u;
+    /* +0 and -0 -> -inf */
+    res.u = ((ux & ~FM_DOUBLE_SIGN64) == 0) ? FM_DOUBLE_NINF64 : res.u;
+    return res.f;
+}
+
+double fm_log2_ieee(double x) 
+{
+    udi_t val;
+    double a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint64_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_log_renorm(&val);
+    hx = val.s.i1;
+    
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_DOUBLE_EMASK) >> FM_DOUBLE_MBITS) - FM_DOUBLE_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_DOUBLE_MMASK;
+    val.s.i1 = hx | FM_DOUBLE_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINE_SHIFT;
+
+    /* compute x value matching table index */
+    val.s.i0 = 0;
+    val.s.i1 = FM_DOUBLE_EZERO | (hx << FM_SPLINE_SHIFT);
+    b = (x - val.f) * fm_log_dinv;
+    a = 1.0 - b;
+
+    /* evaluate spline */
+    y = a * fm_log_q1[hx] + b * fm_log_q1[hx+1];
+    a = (a*a*a-a) * fm_log_q2[hx];
+    b = (b*b*b-b) * fm_log_q2[hx+1];
+    y += (a + b) * fm_log_dsq6;
+
+    return fm_log_special(ux, ((double) ipart) + (y * FM_DOUBLE_LOG2OFE));
+}
+
+double fm_log_ieee(double x) 
+{
+    udi_t val;
+    double a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint64_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_log_renorm(&val);
+    hx = val.s.i1;
+    
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_DOUBLE_EMASK) >> FM_DOUBLE_MBITS) - FM_DOUBLE_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_DOUBLE_MMASK;
+    val.s.i1 = hx | FM_DOUBLE_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINE_SHIFT;
+
+    /* compute x value matching table index */
+    val.s.i0 = 0;
+    val.s.i1 = FM_DOUBLE_EZERO | (hx << FM_SPLINE_SHIFT);
+    b = (x - val.f) * fm_log_dinv;
+    a = 1.0 - b;
+
+    /* evaluate spline */
+    y = a * fm_log_q1[hx] + b * fm_log_q1[hx+1];
+    a = (a*a*a-a) * fm_log_q2[hx];
+    b = (b*b*b-b) * fm_log_q2[hx+1];
+    y += (a + b) * fm_log_dsq6;
+
+    return fm_log_special(ux, ((double)ipart)*FM_DOUBLE_LOGEOF2 + y);
+}
+
+double fm_log10_ieee(double x) 
+{
+    udi_t val;
+    double a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint64_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_log_renorm(&val);
+    hx = val.s.i1;
+    
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_DOUBLE_EMASK) >> FM_DOUBLE_MBITS) - FM_DOUBLE_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_DOUBLE_MMASK;
+    val.s.i1 = hx | FM_DOUBLE_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINE_SHIFT;
+
+    /* compute x value matching table index */
+    val.s.i0 = 0;
+    val.s.i1 = FM_DOUBLE_EZERO | (hx << FM_SPLINE_SHIFT);
+    b = (x - val.f) * fm_log_dinv;
+    a = 1.0 - b;
+
+    /* evaluate spline */
+    y = a * fm_log_q1[hx] + b * fm_log_q1[hx+1];
+    a = (a*a*a-a) * fm_log_q2[hx];
+    b = (b*b*b-b) * fm_log_q2[hx+1];
+    y += (a + b) * fm_log_dsq6;
+
+    return fm_log_special(ux, ((double) ipart)*FM_DOUBLE_LOG10OF2
+                          + (y * FM_DOUBLE_LOG10OFE));
+}
+
+
+/* IEEE-754 conforming single precision variants. same strategy. */
+
+#define FM_FLOAT_SIGN32  0x80000000U
+#define FM_FLOAT_EMASK32 0x7f800000U
+#define FM_FLOAT_QNAN32  0x00400000U
+#define FM_FLOAT_NINF32  0xff800000U
+
+static inline int32_t fm_logf_renorm(ufi_t *val)
+{
+    ufi_t sub;
+    int issub;
+
+    issub = (val->u & FM_FLOAT_EMASK32) == 0;
+    sub.u = (val->u & FM_FLOAT_MMASK) | FM_FLOAT_EZERO;
+    sub.f -= 1.0f;
+    val->u = issub ? sub.u : val->u;
+    return issub ? -(FM_FLOAT_BIAS-1) : 0;
+}
+
+static inline float fm_logf_special(uint32_t ux, float y)
+{
+    ufi_t res;
+
+    res.f = y;
+    res.u = (ux >= FM_FLOAT_EMASK32)
+        ? ((ux > FM_FLOAT_EMASK32) ? (ux | FM_FLOAT_QNAN32) : ux) : res.u;
+    res.u = (ux > FM_FLOAT_SIGN32)
+        ? (FM_FLOAT_EMASK32 | FM_FLOAT_QNAN32 | (ux & FM_FLOAT_MMASK))
+        : res.u;
+    res.u = ((ux & ~FM_FLOAT_SIGN32) == 0) ? FM_FLOAT_NINF32 : res.u;
+    return res.f;
+}
+
+float fm_log2f_ieee(float x) 
+{
+    ufi_t val;
+    float a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint32_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_logf_renorm(&val);
+    hx = val.i;
+
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_FLOAT_EMASK) >> FM_FLOAT_MBITS) - FM_FLOAT_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_FLOAT_MMASK;
+    val.i = hx | FM_FLOAT_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINEF_SHIFT;
+
+    /* compute x value matching table index */
+    val.i = FM_FLOAT_EZERO | (hx << FM_SPLINEF_SHIFT);
+    b = (x - val.f) * fm_logf_dinv;
+    a = 1.0f - b;
+
+    /* evaluate spline */
+    y = a * fm_logf_q1[hx] + b * fm_logf_q1[hx+1];
+    a = (a*a*a-a) * fm_logf_q2[hx];
+    b = (b*b*b-b) * fm_logf_q2[hx+1];
+    y += (a + b) * fm_logf_dsq6;
+
+    return fm_logf_special(ux, ((float) ipart) + (y * FM_FLOAT_LOG2OFE));
+}
+
+float fm_logf_ieee(float x) 
+{
+    ufi_t val;
+    float a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint32_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_logf_renorm(&val);
+    hx = val.i;
+    
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_FLOAT_EMASK) >> FM_FLOAT_MBITS) - FM_FLOAT_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_FLOAT_MMASK;
+    val.i = hx | FM_FLOAT_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINEF_SHIFT;
+
+    /* compute x value matching table index */
+    val.i = FM_FLOAT_EZERO | (hx << FM_SPLINEF_SHIFT);
+    b = (x - val.f) * fm_logf_dinv;
+    a = 1.0f - b;
+
+    /* evaluate spline */
+    y = a * fm_logf_q1[hx] + b * fm_logf_q1[hx+1];
+    a = (a*a*a-a) * fm_logf_q2[hx];
+    b = (b*b*b-b) * fm_logf_q2[hx+1];
+    y += (a + b) * fm_logf_dsq6;
+
+    return fm_logf_special(ux, ((float)ipart)*FM_FLOAT_LOGEOF2 + y);
+}
+
+float fm_log10f_ieee(float x) 
+{
+    ufi_t val;
+    float a,b,y;
+    int32_t hx, ipart, ecorr;
+    uint32_t ux;
+
+    val.f = x;
+    ux = val.u;
+    ecorr = fm_logf_renorm(&val);
+    hx = val.i;
+    
+    /* extract exponent and subtract bias */
+    ipart = (((hx & FM_FLOAT_EMASK) >> FM_FLOAT_MBITS) - FM_FLOAT_BIAS);
+    ipart += ecorr;
+
+    /* mask out exponent to get the prefactor to 2**ipart */
+    hx &= FM_FLOAT_MMASK;
+    val.i = hx | FM_FLOAT_EZERO;
+    x = val.f;
+
+    /* table index */
+    hx >>= FM_SPLINEF_SHIFT;
+
+    /* compute x value matching table index */
+    val.i = FM_FLOAT_EZERO | (hx << FM_SPLINEF_SHIFT);
+    b = (x - val.f) * fm_logf_dinv;
+    a = 1.0f - b;
+
+    /* evaluate spline */
+    y = a * fm_logf_q1[hx] + b * fm_logf_q1[hx+1];
+    a = (a*a*a-a) * fm_logf_q2[hx];
+    b = (b*b*b-b) * fm_logf_q2[hx+1];
+    y += (a + b) * fm_logf_dsq6;
+
+    return fm_logf_special(ux, ((float)ipart)*FM_FLOAT_LOG10OF2
+                           + y*FM_FLOAT_LOG10OFE);
+}
+
 #if defined(LIBM_ALIAS) && defined(USE_LOG_SPLINE)
 /* include aliases to the equivalent libm functions for use with LD_PRELOAD. */
+#if defined(USE_LOG_IEEE)
+double log(double x) __attribute__ ((alias("fm_log_ieee")));
+double log2(double x) __attribute__ ((alias("fm_log2_ieee")));
+double log10(double x) __attribute__ ((alias("fm_log10_ieee")));
+float logf(float x) __attribute__ ((alias("fm_logf_ieee")));
+float log2f(float x) __attribute__ ((alias("fm_log2f_ieee")));
+float log10f(float x) __attribute__ ((alias("fm_log10f_ieee")));
+#else
 double log(double x) __attribute__ ((alias("fm_log")));
 double log2(double x) __attribute__ ((alias("fm_log2")));
 double log10(double x) __attribute__ ((alias("fm_log10")));
@@ -314,6 +705,7 @@ float logf(float x) __attribute__ ((alias("fm_logf")));
 float log2f(float x) __attribute__ ((alias("fm_log2f")));
 float log10f(float x) __attribute__ ((alias("fm_log10f")));
 #endif
+#endif
 
 
 /* 
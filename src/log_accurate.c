@@ -0,0 +1,184 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* near correctly rounded version of log(x) in double precision.
+ *
+ * strategy:
+ *
+ * table lookup in the style of Tang with the same 256 cells as the
+ * compact log(). for each cell the table from genspline holds 1/c for
+ * the center c of the cell and log(c) as the sum of two doubles, so that
+ *   log(x) = ipart*log(2) + log(c) + log1p(r), r = (fpart - c)/c.
+ * log(2) is split into a leading part with 32 bits and a trailing part,
+ * and the leading part of log(c) is a multiple of 2**-43, so that their
+ * sum w is exact. w + r is then formed with an exact two-sum and all
+ * small terms are added to its rounding error before the final rounding.
+ * the cells within 2**-6 of 1.0 use c = 1.0, where r = fpart - 1 is exact,
+ * thus log1p(r) - r is approximated by its taylor series up to r**10.
+ * for the remaining cells |r| < 2**-9 and |r| is small against log(c).
+ *
+ * the error stays below 1 ulp for all positive normalized arguments.
+ * log2() and log10() multiply the two-double result with a constant that
+ * is split into a 26-bit leading part and a trailing part. this does
+ * not require an FMA instruction.
+ */
+
+/* -ffast-math would otherwise combine the conversion of the exponent
+ * via the 2**52 shifter below into a no-op and cancel the two-sum. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "log_accurate_tbl.c"
+
+/* 2**52 + 2**11, see log_poly_kernel.c */
+#define FM_DOUBLE_EXPCVT_BITS 0x4330000000000800ULL
+#define FM_DOUBLE_EXPCVT      4503599627372544.0
+
+/* log(2) with 32 significant bits in the leading part */
+#define FM_LOG_ACCURATE_LN2_HI  6.93147180369123816490e-01
+#define FM_LOG_ACCURATE_LN2_LO  1.90821492927058770002e-10
+/* 1/log(2) and 1/log(10) with 26 significant bits in the leading part */
+#define FM_LOG_ACCURATE_LOG2E_HI   1.44269502162933349609e+00
+#define FM_LOG_ACCURATE_LOG2E_LO   1.92596299112939017828e-08
+#define FM_LOG_ACCURATE_LOG10E_HI  4.34294477105140686035e-01
+#define FM_LOG_ACCURATE_LOG10E_LO  4.79811114161032316316e-09
+#define FM_LOG_ACCURATE_SPLIT_MASK 0xfffffffff8000000ULL
+
+/* returns the leading part of log(x), the trailing part is
+   stored in *tail. */
+static inline double fm_log_accurate_dd(double x, double *tail)
+{
+    udi_t val, ival, cval;
+    double r, r2, r4, q, q4, ipart, invc, w, hi;
+    uint64_t tmp;
+    int i;
+
+    val.f = x;
+    tmp = val.u - FM_LOG_ACCURATE_OFF;
+    i = (int) ((tmp >> (52 - FM_LOG_ACCURATE_BITS))
+               & ((1 << FM_LOG_ACCURATE_BITS) - 1));
+    ival.u = FM_DOUBLE_EXPCVT_BITS ^ (tmp >> 52);
+    ipart = ival.f - FM_DOUBLE_EXPCVT;
+    val.u -= tmp & 0xfff0000000000000ULL;
+
+    /* the center of the cell has only 10 significant bits,
+       so that fpart - c is exact */
+    cval.u = (val.u & ~((1ULL << (52 - FM_LOG_ACCURATE_BITS)) - 1))
+        | (1ULL << (51 - FM_LOG_ACCURATE_BITS));
+    invc = fm_log_accurate_tbl[3*i];
+    cval.f = (invc == 1.0) ? 1.0 : cval.f;
+    r = (val.f - cval.f) * invc;
+    r2 = r*r;
+
+    /* log1p(r) - r = r**2 * q(r), evaluated with Estrin's scheme,
+       which halves the dependency chain of the polynomial */
+    r4 = r2*r2;
+    q4 = FM_FMA(r, 1.0/7.0, -1.0/6.0) + r2*FM_FMA(r, 1.0/9.0, -1.0/8.0);
+    q4 = q4 - r4*0.1;
+    q = FM_FMA(r, 1.0/3.0, -0.5) + r2*FM_FMA(r, 0.2, -0.25);
+    q = q + r4*q4;
+
+    w = FM_FMA(ipart, FM_LOG_ACCURATE_LN2_HI, fm_log_accurate_tbl[3*i+1]);
+    hi = w + r;
+    *tail = ((w - hi) + r)
+        + (FM_FMA(ipart, FM_LOG_ACCURATE_LN2_LO, fm_log_accurate_tbl[3*i+2])
+           + r2*q);
+    return hi;
+}
+
+/* multiply hi + lo with the constant khi + klo, where khi has
+   26 significant bits, so that hh*khi is exact */
+static inline double fm_log_accurate_scale(double hi, double lo,
+                                           double khi, double klo)
+{
+    udi_t hh;
+
+    hh.f = hi;
+    hh.u &= FM_LOG_ACCURATE_SPLIT_MASK;
+    return hh.f*khi + (((hi - hh.f)*khi + hi*klo) + lo*(khi + klo));
+}
+
+static inline double fm_log_accurate_inl(double x)
+{
+    double hi, lo;
+
+    hi = fm_log_accurate_dd(x, &lo);
+    return hi + lo;
+}
+
+static inline double fm_log2_accurate_inl(double x)
+{
+    double hi, lo;
+
+    hi = fm_log_accurate_dd(x, &lo);
+    return fm_log_accurate_scale(hi, lo, FM_LOG_ACCURATE_LOG2E_HI,
+                                 FM_LOG_ACCURATE_LOG2E_LO);
+}
+
+static inline double fm_log10_accurate_inl(double x)
+{
+    double hi, lo;
+
+    hi = fm_log_accurate_dd(x, &lo);
+    return fm_log_accurate_scale(hi, lo, FM_LOG_ACCURATE_LOG10E_HI,
+                                 FM_LOG_ACCURATE_LOG10E_LO);
+}
+
+double fm_log_accurate(double x)
+{
+    return fm_log_accurate_inl(x);
+}
+
+double fm_log2_accurate(double x)
+{
+    return fm_log2_accurate_inl(x);
+}
+
+double fm_log10_accurate(double x)
+{
+    return fm_log10_accurate_inl(x);
+}
+
+FM_BATCH_DEF(double,fm_log_accurate,fm_log_accurate_inl)
+FM_BATCH_DEF(double,fm_log2_accurate,fm_log2_accurate_inl)
+FM_BATCH_DEF(double,fm_log10_accurate,fm_log10_accurate_inl)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,290 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define FM_LOG_ACCURATE_BITS 8
+#define FM_LOG_ACCURATE_OFF  0x3fe6000000000000ULL
+/* triples of 1/c, log(c) leading part, log(c) trailing part */
+static const double fm_log_accurate_tbl[] __attribute__ ((aligned(64))) = {
+ 1.45248226950354619724e+00, -3.73274002787184144836e-01, -2.96529294174785462701e-16,
+ 1.44837340876944842272e+00, -3.70441139702847976878e-01, -3.23613206544559606215e-14,
+ 1.44428772919605075131e+00, -3.67616279067306095385e-01, -1.94996200176406064841e-14,
+ 1.44022503516174404936e+00, -3.64799375796224012447e-01,  1.17952251698499877008e-14,
+ 1.43618513323983165719e+00, -3.61990385185208651819e-01,  5.14943719175792180565e-14,
+ 1.43216783216783216659e+00, -3.59189262905488249089e-01,  4.28096414654272061640e-14,
+ 1.42817294281729423311e+00, -3.56395964999819625518e-01, -1.31103081949662803041e-14,
+ 1.42420027816411676191e+00, -3.53610447878395461885e-01, -1.09437740987428089312e-14,
+ 1.42024965325936203264e+00, -3.50832668314524198649e-01,  2.01803363516356304430e-14,
+ 1.41632088520055332559e+00, -3.48062583440650996636e-01, -3.74106670121554518715e-14,
+ 1.41241379310344816744e+00, -3.45300150744833445060e-01,  5.51272623470350220387e-14,
+ 1.40852819807427787069e+00, -3.42545328065966714348e-01,  3.29860921563507325516e-14,
+ 1.40466392318244159831e+00, -3.39798073590827698354e-01,  3.27525550083973548965e-14,
+ 1.40082079343365251134e+00, -3.37058345849641227687e-01, -3.33627710961265089296e-14,
+ 1.39699863574351978990e+00, -3.34326103712783151423e-01, -1.84504917854350081186e-14,
+ 1.39319727891156452948e+00, -3.31601306386573924101e-01, -4.24938675826908029975e-14,
+ 1.38941655359565796601e+00, -3.28883913410095374275e-01, -2.11161654568164935952e-14,
+ 1.38565629228687425822e+00, -3.26173884651211665187e-01, -3.96547757738202610867e-14,
+ 1.38191632928475027775e+00, -3.23471180303386063315e-01,  1.98565935829314588190e-14,
+ 1.37819650067294752205e+00, -3.20775760881701899052e-01,  7.96972622445213385589e-15,
+ 1.37449664429530193921e+00, -3.18087587219906708924e-01,  1.31303388301029499985e-14,
+ 1.37081659973226233085e+00, -3.15406620466660569946e-01,  2.47820427373701690499e-14,
+ 1.36715620827770356627e+00, -3.12732822082239181327e-01,  5.56556211707415204870e-15,
+ 1.36351531291611194341e+00, -3.10066153835350633017e-01,  3.22830954677111314766e-14,
+ 1.35989375830013270452e+00, -3.07406577799611113733e-01,  5.15971813885851560144e-14,
+ 1.35629139072847682002e+00, -3.04754056350475366344e-01,  4.69755527879311962636e-14,
+ 1.35270805812417438396e+00, -3.02108552162053456414e-01,  4.91385090169854654718e-14,
+ 1.34914361001317528732e+00, -2.99470028203813853906e-01, -9.31400139306259866601e-15,
+ 1.34559789750328517854e+00, -2.96838447737741262245e-01, -2.59955631239788820253e-14,
+ 1.34207077326343382495e+00, -2.94213774315039700014e-01,  4.36113276568173002801e-14,
+ 1.33856209150326788127e+00, -2.91595971772949269507e-01,  3.20129664964363680468e-14,
+ 1.33507170795306384647e+00, -2.88985004232245046296e-01,  4.81387932987908939708e-14,
+ 1.33159947984395321541e+00, -2.86380836093826474098e-01,  1.73544447042150995486e-14,
+ 1.32814526588845649435e+00, -2.83783432036102567508e-01, -2.10369102780078032211e-14,
+ 1.32470892626131964143e+00, -2.81192757012036054221e-01,  4.92165444683501096534e-15,
+ 1.32129032258064516014e+00, -2.78608776246073830407e-01, -3.22686484737627621300e-14,
+ 1.31788931788931784617e+00, -2.76031455231759537128e-01, -4.61161870409648733116e-14,
+ 1.31450577663671364093e+00, -2.73460759728664015711e-01, -4.08146010478366294549e-14,
+ 1.31113956466069137008e+00, -2.70896655759770510485e-01,  3.38170789114522474250e-15,
+ 1.30779054916985959522e+00, -2.68339109608632497839e-01, -1.74949573057692209233e-14,
+ 1.30445859872611458208e+00, -2.65788087817099949461e-01,  5.52873176927481946308e-14,
+ 1.30114358322744605445e+00, -2.63243557182022414054e-01, -2.74529747892882092231e-14,
+ 1.29784537389100118610e+00, -2.60705484753543714760e-01, -3.51369324261274762478e-14,
+ 1.29456384323640971701e+00, -2.58173837831805030874e-01,  5.81037496762137894990e-15,
+ 1.29129886506935687152e+00, -2.55648583964557474246e-01, -4.76351271795627528860e-14,
+ 1.28805031446540874107e+00, -2.53129690945115726208e-01, -5.46782129122458382398e-15,
+ 1.28481806775407769727e+00, -2.50617126809288492950e-01,  5.04380879510352153616e-14,
+ 1.28160200250312894532e+00, -2.48110859833218455606e-01,  4.00285002626760144651e-14,
+ 1.27840199750312111249e+00, -2.45610858531108533498e-01,  1.46604326985502741998e-14,
+ 1.27521793275217931729e+00, -2.43117091652720773709e-01,  2.93526867308629979547e-14,
+ 1.27204968944099383599e+00, -2.40629528180875240650e-01, -1.44830165655501774680e-14,
+ 1.26889714993804214593e+00, -2.38148137329517339822e-01,  1.30432638431252079236e-14,
+ 1.26576019777503079311e+00, -2.35672888540989333706e-01,  2.79289666480636578072e-14,
+ 1.26263871763255242087e+00, -2.33203751483983978687e-01, -5.61942934676137872962e-14,
+ 1.25953259532595329695e+00, -2.30740696051611848816e-01, -3.06538648631171639636e-14,
+ 1.25644171779141111678e+00, -2.28283692358559164859e-01, -3.12206451013111174753e-14,
+ 1.25336597307221531139e+00, -2.25832710739496178576e-01,  4.59678817362960123738e-14,
+ 1.25030525030525030417e+00, -2.23387721746348688612e-01, -3.49816069123917716688e-14,
+ 1.24725943970767350066e+00, -2.20948696147047485283e-01,  2.26127168205525475031e-14,
+ 1.24422843256379089816e+00, -2.18515604922345119121e-01, -3.81631439774418601552e-14,
+ 1.24121212121212121104e+00, -2.16088419264792719332e-01,  2.06098159372114508869e-14,
+ 1.23821039903264806803e+00, -2.13667110575784136017e-01,  2.23563301118140378421e-14,
+ 1.23522316043425806065e+00, -2.11251650464191698120e-01,  3.35785408809782803807e-14,
+ 1.23225030084235864791e+00, -2.08842010743978789833e-01, -2.61130770869491546371e-14,
+ 1.22929171668667458484e+00, -2.06438163432608234871e-01, -2.16883802584000306979e-15,
+ 1.22634730538922154253e+00, -2.04040080748541186040e-01, -5.64262720749442170387e-14,
+ 1.22341696535244914834e+00, -2.01647735109986570023e-01,  8.79596959504902464744e-15,
+ 1.22050059594755655468e+00, -1.99261099132286290114e-01,  3.93731407069899952411e-14,
+ 1.21759809750297254283e+00, -1.96880145626550984161e-01,  4.59443545491530769276e-14,
+ 1.21470937129300127211e+00, -1.94504847597613661492e-01,  1.60238169304507960256e-14,
+ 1.21183431952662723496e+00, -1.92135178242324400344e-01,  4.51528734107115026220e-14,
+ 1.20897284533648163851e+00, -1.89771110947390297952e-01, -8.40298696510449749653e-15,
+ 1.20612485276796221889e+00, -1.87412619288124915329e-01,  1.91371983364330144894e-14,
+ 1.20329024676850759867e+00, -1.85059677026060853677e-01, -1.81053224712970917132e-14,
+ 1.20046893317702219051e+00, -1.82712258107812886010e-01,  3.89097798035240027836e-14,
+ 1.19766081871345031473e+00, -1.80370336662690533558e-01, -2.34321839275714038919e-15,
+ 1.19486581096849464600e+00, -1.78033887001674884232e-01,  1.57946572487688285946e-15,
+ 1.19208381839348076525e+00, -1.75702883615144855867e-01, -5.28669854204730227387e-14,
+ 1.18931475029036004543e+00, -1.73377301171740327845e-01,  1.80340361784561697966e-14,
+ 1.18655851680185397967e+00, -1.71057114515974717506e-01, -5.04312303722942445461e-14,
+ 1.18381502890173417875e+00, -1.68742298667552859115e-01, -2.09135280707789528165e-14,
+ 1.18108419838523648338e+00, -1.66432828818869893439e-01, -4.13488416683288617648e-14,
+ 1.17836593785960874747e+00, -1.64128680334101773042e-01,  4.07171041674758704687e-14,
+ 1.17566016073478762927e+00, -1.61829828746931525529e-01, -1.87729199590050410684e-14,
+ 1.17296678121420394625e+00, -1.59536249759867132525e-01,  1.62432594501618621230e-14,
+ 1.17028571428571437352e+00, -1.57247919241854106076e-01,  1.54408143172510281538e-14,
+ 1.16761687571265682095e+00, -1.54964813227252307115e-01, -1.77468716805462278785e-14,
+ 1.16496018202502837902e+00, -1.52686907914244329731e-01, -3.17671101012981238476e-14,
+ 1.16231555051078316865e+00, -1.50414179663243885443e-01, -2.97003632625247870891e-14,
+ 1.15968289920724809683e+00, -1.48146604995531561144e-01,  3.84804899533283673030e-14,
+ 1.15706214689265540763e+00, -1.45884160591549516539e-01,  2.59389813231022947626e-14,
+ 1.15445321307779025233e+00, -1.43626823289878302603e-01,  4.69883734786208373535e-15,
+ 1.15185601799775039211e+00, -1.41374570085531559016e-01, -1.69570032928362257607e-14,
+ 1.14927048260381603484e+00, -1.39127378128591772111e-01, -5.20124172681199481438e-14,
+ 1.14669652855543113823e+00, -1.36885224722959719657e-01,  5.67231537348250602903e-15,
+ 1.14413407821229040628e+00, -1.34648087324649168295e-01,  5.14449051934595669167e-14,
+ 1.14158305462653286710e+00, -1.32415943540650005161e-01, -6.97075589525114613920e-15,
+ 1.13904338153503892350e+00, -1.30188771127791369508e-01, -4.14515562716447072411e-14,
+ 1.13651498335183132049e+00, -1.27966547991150036978e-01,  3.48571947130990600350e-14,
+ 1.13399778516057581079e+00, -1.25749252182458803873e-01, -8.87033231155437418280e-15,
+ 1.13149171270718240656e+00, -1.23536861899538052967e-01,  1.10802344946772657330e-14,
+ 1.12899669239250277641e+00, -1.21329355484363077267e-01,  4.65860328286750446924e-14,
+ 1.12651265126512645232e+00, -1.19126711421927211632e-01, -4.70488651835819504665e-14,
+ 1.12403951701427007315e+00, -1.16928908339446024911e-01, -4.87483182076350884948e-14,
+ 1.12157721796276010906e+00, -1.14735925004538330541e-01,  5.37039081824688957489e-14,
+ 1.11912568306010928865e+00, -1.12547740323975631327e-01,  4.38518985663646776452e-14,
+ 1.11668484187568162191e+00, -1.10364333342999998422e-01,  1.17535037150000298833e-14,
+ 1.11425462459194779541e+00, -1.08185683243732455594e-01, -3.35890034319427654985e-14,
+ 1.11183496199782849700e+00, -1.06011769344149797689e-01,  3.54851239538211959967e-15,
+ 1.10942578548212344991e+00, -1.03842571096606661740e-01,  5.72494661269309923490e-15,
+ 1.10702702702702704407e+00, -1.01678068087039719103e-01,  1.18185016352405358742e-14,
+ 1.10463861920172590203e+00, -9.95182400336034334032e-02,  5.49279182250964059797e-15,
+ 1.10226049515608170992e+00, -9.73630667856468789978e-02,  3.23021164395746740450e-14,
+ 1.09989258861439309634e+00, -9.52125283223494989215e-02, -3.65250296912970895402e-14,
+ 1.09753483386923900156e+00, -9.30666047521526706987e-02,  4.34021172951090661307e-14,
+ 1.09518716577540109469e+00, -9.09252763107133432641e-02, -5.27519990038173569591e-14,
+ 1.09284951974386346230e+00, -8.87885233610177238006e-02, -1.31825770460260172090e-14,
+ 1.09052183173588934650e+00, -8.66563263912212278228e-02,  3.10417246377966971060e-14,
+ 1.08820403825717315627e+00, -8.45286660140800449881e-02,  6.58562695479356086103e-15,
+ 1.08589607635206797376e+00, -8.24055229660416443949e-02,  4.60448939718603733606e-14,
+ 1.08359788359788367096e+00, -8.02868781057668456924e-02,  5.65054120572720808280e-14,
+ 1.08130939809926074346e+00, -7.81727124133340112166e-02, -4.08389888204539752703e-14,
+ 1.07903055848261320016e+00, -7.60630069895569249638e-02,  3.16959390049380285159e-14,
+ 1.07676130389064139692e+00, -7.39577430540521163493e-02, -1.06722288883802363113e-14,
+ 1.07450157397691503647e+00, -7.18569019452388602076e-02, -1.21216784439853730859e-14,
+ 1.07225130890052366972e+00, -6.97604651187475610641e-02,  2.47143410879620273324e-14,
+ 1.07001044932079425465e+00, -6.76684141465102584334e-02,  1.14269013630659277414e-14,
+ 1.06777893639207510645e+00, -6.55807307159648189554e-02, -5.00547953780072774066e-14,
+ 1.06555671175858490685e+00, -6.34973966291454416933e-02, -1.51606225945628836360e-14,
+ 1.06334371754932499599e+00, -6.14183938013184160809e-02, -9.12199596457899386515e-15,
+ 1.06113989637305694558e+00, -5.93437042604136877344e-02, -5.34799831644009598941e-14,
+ 1.05894519131334030604e+00, -5.72733101461153637501e-02, -4.34046685583461960833e-14,
+ 1.05675954592363252615e+00, -5.52071937087248443277e-02,  3.79818077759618705214e-14,
+ 1.05458290422245104523e+00, -5.31453373081376412301e-02,  9.45831886661578635778e-15,
+ 1.05241521068859200660e+00, -5.10877234135023172712e-02,  5.42853929126271839145e-14,
+ 1.05025641025641025550e+00, -4.90343346016288705869e-02,  2.29530648231546924309e-14,
+ 1.04810644831115662434e+00, -4.69851535566476741224e-02, -2.26796967978896285567e-14,
+ 1.04596527068437183949e+00, -4.49401630689862940926e-02,  4.35822981436490008988e-14,
+ 1.04383282364933749342e+00, -4.28993460341189347673e-02,  2.89237627989005763318e-14,
+ 1.04170905391658186190e+00, -4.08626854523390647955e-02,  5.25226834680730947369e-14,
+ 1.03959390862944167644e+00, -3.88301644273951751529e-02,  3.09623610387707581815e-14,
+ 1.03748733535967585517e+00, -3.68017661659223449533e-02, -4.91658986743678805276e-14,
+ 1.03538928210313452283e+00, -3.47774739767601204221e-02,  1.91405288699816183984e-14,
+ 1.03329969727547932301e+00, -3.27572712694745860063e-02,  9.48168342343284897833e-15,
+ 1.03121852970795568893e+00, -3.07411415542446775362e-02, -3.58244572109525302728e-14,
+ 1.02914572864321618439e+00, -2.87290684408390006865e-02, -2.13234750765910890946e-14,
+ 1.02708124373119358275e+00, -2.67210356375926494366e-02, -2.21144954291093570609e-14,
+ 1.02502502502502501613e+00, -2.47170269509524587193e-02,  5.28831010693274830570e-14,
+ 1.02297702297702297614e+00, -2.27170262842264492065e-02, -6.05974485542483398692e-15,
+ 1.02093718843469583035e+00, -2.07210176374701404711e-02, -4.74228353119924075920e-14,
+ 1.01890547263681585655e+00, -1.87289851062359957723e-02, -4.09727336287595347852e-14,
+ 1.01688182720953324001e+00, -1.67409128808913010289e-02,  5.01009823905551598955e-16,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 9.82725527831094014530e-01,  1.74254167138769844314e-02, -1.78510973906399750266e-14,
+ 9.78967495219885242008e-01,  2.12568390254546102369e-02, -3.94941817151526347596e-14,
+ 9.75238095238095237249e-01,  2.50736375521682930412e-02, -5.23320942786772991262e-14,
+ 9.71537001897533225581e-01,  2.88759235018005711026e-02,  5.39703220672370018174e-14,
+ 9.67863894139886604684e-01,  3.26638068188458419172e-02, -5.42450572036789341324e-14,
+ 9.64218455743879432340e-01,  3.64373962024728825781e-02, -4.18339272728260325174e-14,
+ 9.60600375234521575152e-01,  4.01967991263063595397e-02,  3.03956248462900618934e-14,
+ 9.57009345794392563000e-01,  4.39421218565030358150e-02, -4.27266457891234407995e-15,
+ 9.53445065176908745919e-01,  4.76734694693732308224e-02, -1.63280034024687603633e-14,
+ 9.49907235621521350843e-01,  5.13909458694570275838e-02,  3.23419337643592041953e-14,
+ 9.46395563770794812086e-01,  5.50946538069183588959e-02,  5.53779197249183036122e-14,
+ 9.42909760589318635127e-01,  5.87846948944843461504e-02, -5.66926707131192725297e-14,
+ 9.39449541284403721875e-01,  6.24611696237025171285e-02,  3.37730941845672261170e-14,
+ 9.36014625228519192568e-01,  6.61241773824485790101e-02,  2.48418703685006347914e-14,
+ 9.32604735883424407206e-01,  6.97738164700467677903e-02, -2.39210032533000716004e-14,
+ 9.29219600725952776799e-01,  7.34101841134133792366e-02, -6.67680158123601374953e-15,
+ 9.25858951175406841294e-01,  7.70333764828592393314e-02, -3.22248060484128795444e-14,
+ 9.22522522522522536725e-01,  8.06434887069826800143e-02, -5.59544069606877914058e-14,
+ 9.19210053859964126843e-01,  8.42406148877898885985e-02, -1.36514402755173736015e-14,
+ 9.15921288014311274495e-01,  8.78248481155878835125e-02,  3.49125974441130693116e-15,
+ 9.12655971479500838228e-01,  9.13962804831953690154e-02, -6.83806310186607646529e-15,
+ 9.09413854351687422906e-01,  9.49550031001535899122e-02,  2.90073344576084746205e-14,
+ 9.06194690265486713088e-01,  9.85011061069371862686e-02, -4.02784495210153914435e-15,
+ 9.02998236331569614777e-01,  1.02034678688255553425e-01, -1.12674965386562464520e-14,
+ 8.99824253075571123262e-01,  1.05555809086808949360e-01,  1.41868667421357619318e-14,
+ 8.96672504378283719007e-01,  1.09064584616476167866e-01,  2.62641064495763854048e-14,
+ 8.93542757417102984085e-01,  1.12561091675274838053e-01, -4.30585607317027219132e-14,
+ 8.90434782608695685191e-01,  1.16045415757866976492e-01, -2.43212364852730955622e-14,
+ 8.87348353552859570037e-01,  1.19517641468632973556e-01, -4.11968297474828160087e-14,
+ 8.84283246977547454648e-01,  1.22977852533495024545e-01, -7.56605065058146841750e-15,
+ 8.81239242685025847557e-01,  1.26426131812422681833e-01, -1.92380020334198542642e-14,
+ 8.78216123499142353737e-01,  1.29862561311028912314e-01, -4.43188644420541844049e-14,
+ 8.75213675213675212916e-01,  1.33287222192393528530e-01, -4.48198336083782677974e-14,
+ 8.72231686541737660789e-01,  1.36700194788545559277e-01,  4.31042734058001419939e-14,
+ 8.69269949066213909461e-01,  1.40101558612059307052e-01,  1.96141388721093878900e-14,
+ 8.66328257191201323018e-01,  1.43491392366627223964e-01, -3.68105475571575690985e-14,
+ 8.63406408094435029454e-01,  1.46869773958201221831e-01,  1.64459645988351832457e-14,
+ 8.60504201680672320407e-01,  1.50236780506133982271e-01, -1.20070647218264991984e-14,
+ 8.57621440536013412981e-01,  1.53592488353069711593e-01,  2.45904642134919804164e-14,
+ 8.54757929883138589666e-01,  1.56936973075971764047e-01, -3.01999907286604196699e-14,
+ 8.51913477537437624498e-01,  1.60270309495672336197e-01,  2.74583280375148564012e-14,
+ 8.49087893864013287804e-01,  1.63592571687672716507e-01,  4.94119719099406218277e-15,
+ 8.46280991735537169163e-01,  1.66903832991351919190e-01, -1.82412136610909936252e-14,
+ 8.43492586490939055821e-01,  1.70204166019971125934e-01,  1.93514637907704623032e-14,
+ 8.40722495894909660485e-01,  1.73493642670337067102e-01,  5.21718220925296294332e-14,
+ 8.37970540098199712098e-01,  1.76772334132124342432e-01, -3.68043133946657774480e-14,
+ 8.35236541598694981481e-01,  1.80040310896742994373e-01, -3.93796865776063764741e-14,
+ 8.32520325203252031798e-01,  1.83297642767001889297e-01,  8.19580948246967366799e-15,
+ 8.29821717990275486976e-01,  1.86544398865862603998e-01,  1.74252431060784029881e-14,
+ 8.27140549273021052912e-01,  1.89780647645079625363e-01,  8.69211657945206939146e-15,
+ 8.24476650563607083022e-01,  1.93006456893954236875e-01,  1.67433612547479571120e-14,
+ 8.21829855537720699310e-01,  1.96221893747974718281e-01, -2.93596120722397491143e-14,
+ 8.19200000000000039257e-01,  1.99427024696888111066e-01,  5.60258762126453202512e-15,
+ 8.16586921850079749952e-01,  2.02621915593454104965e-01, -4.11942479910595849013e-14,
+ 8.13990461049284630413e-01,  2.05806631660948369245e-01, -1.56293841801005695125e-14,
+ 8.11410459587955656957e-01,  2.08981237501689065539e-01,  1.63069834328496976461e-14,
+ 8.08846761453396512209e-01,  2.12145797104653865972e-01,  1.45364135225450885613e-14,
+ 8.06299212598425185661e-01,  2.15300373853210658126e-01, -2.67952299888227218894e-14,
+ 8.03767660910518100259e-01,  2.18445030532620876329e-01,  3.46851860384342347565e-14,
+ 8.01251956181533664392e-01,  2.21579829337997580296e-01,  2.94390705389557805205e-14,
+ 7.98751950078003147837e-01,  2.24704831881126665394e-01,  3.55896817008302668306e-14,
+ 7.96267496111975114914e-01,  2.27820099198083880765e-01,  2.77217485078473657722e-14,
+ 7.93798449612403089759e-01,  2.30925691756283413270e-01, -1.87085590075408703115e-14,
+ 7.91344667697063353096e-01,  2.34021669461412784585e-01, -2.00046820471658226559e-14,
+ 7.88906009244992323381e-01,  2.37108091664595121983e-01, -1.29120618277273058183e-14,
+ 7.86482334869431642943e-01,  2.40185017169096681755e-01, -3.52240751757409986666e-14,
+ 7.84073506891271088115e-01,  2.43252504236920685798e-01,  2.59086372147998567073e-15,
+ 7.81679389312977090931e-01,  2.46310610595742218720e-01,  1.91528379527711178909e-15,
+ 7.79299847792998434670e-01,  2.49359393445047317073e-01,  5.54100629312007098015e-14,
+ 7.76934749620637354894e-01,  2.52398909462954179617e-01,  4.52548426250337643140e-14,
+ 7.74583963691376720107e-01,  2.55429214812124882883e-01,  5.36182155532610726922e-14,
+ 7.72247360482654632285e-01,  2.58450365146359217761e-01, -4.49480405152746786968e-15,
+ 7.69924812030075234048e-01,  2.61462415616392718221e-01, -4.63632496110200076345e-14,
+ 7.67616191904047950878e-01,  2.64465420876149437390e-01, -3.35041510594186187078e-14,
+ 7.65321375186846064587e-01,  2.67459435088767349953e-01, -4.66846613450533354239e-14,
+ 7.63040238450074514986e-01,  2.70444511932169007196e-01,  5.00085541553507706425e-15,
+ 7.60772659732540823541e-01,  2.73420704605200626247e-01,  1.93935850451715241505e-14,
+ 7.58518518518518480853e-01,  2.76388065832975371450e-01,  4.66671785850220066649e-14,
+ 7.56277695716395914616e-01,  2.79346647872785069922e-01, -1.78614447451236335596e-14,
+ 7.54050073637702489293e-01,  2.82296502519216119254e-01, -2.77767717681010051223e-14,
+ 7.51835535976505098255e-01,  2.85237681110061203071e-01, -5.66214013609372956992e-14,
+ 7.49633967789165467366e-01,  2.88170234531321511895e-01, -3.92332650742122091003e-14,
+ 7.47445255474452507904e-01,  2.91094213222663711349e-01,  5.37938292001494122729e-14,
+ 7.45269286754002946438e-01,  2.94009667182876910374e-01, -3.53552907436660568408e-14,
+ 7.43105950653120461702e-01,  2.96916645974192761059e-01, -4.19756189442427318781e-14,
+ 7.40955137481910219854e-01,  2.99815198728197174205e-01, -3.50623393166604735427e-14,
+ 7.38816738816738816098e-01,  3.02705374150377792830e-01,  1.76543892352332143503e-14,
+ 7.36690647482014404623e-01,  3.05587220525239899871e-01,  4.44471662166406877859e-14,
+ 7.34576757532281243712e-01,  3.08460785720967578527e-01,  4.85208390393204735958e-14,
+ 7.32474964234620884440e-01,  3.11326117194312246284e-01, -9.77432653044563171107e-15,
+ 7.30385164051355229020e-01,  3.14183261995026441582e-01,  5.58641674586191072649e-14,
+ 7.28307254623044131314e-01,  3.17032266771207105194e-01, -4.99855690692940779485e-14
+};
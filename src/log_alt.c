@@ -283,6 +283,60 @@ float fm_log2f_alt(float x)
     return ((float)ipart) + z;
 }
 
+/* latency optimized variant of fm_log2f_alt().
+ *
+ * same as fm_log2f_alt(), but the degree 8 polynomial is evaluated
+ * with the Estrin scheme, i.e. in 4 instead of 8 dependent steps.
+ */
+
+float fm_log2f_alt_lat(float x) 
+{
+    ufi_t val;
+    float z,px,x2,x4,x8,a,b,c,d;
+    int32_t ipart,fpart;
+
+    val.f = x;
+    /* extract exponent and part of the mantissa */
+    fpart = val.i & FM_FLOAT_MMASK;
+    ipart = val.i & FM_FLOAT_EMASK;
+
+    /* set exponent to 0 to get the prefactor to 2**ipart */
+    fpart |= FM_FLOAT_EZERO;
+    val.i = fpart;
+    x = val.f;
+
+    /* extract exponent */
+    ipart >>= FM_FLOAT_MBITS;
+    ipart -= FM_FLOAT_BIAS;
+
+    /* the polynomial is computed for sqrt(0.5) < x < sqrt(2),
+       but we have the mantissa in the interval 1 < x < 2.
+       adjust by dividing x by 2 and incrementing ipart, if needed. */
+    if (x > FM_FLOAT_SQRT2) {
+        x *= 0.5;
+        ++ipart;
+    }
+
+    /* use polynomial approximation for log(1+x) */
+    x -= 1.0;
+
+    x2 = x*x;
+    a  = fm_log2f_p[7]*x + fm_log2f_p[8];
+    b  = fm_log2f_p[5]*x + fm_log2f_p[6];
+    c  = fm_log2f_p[3]*x + fm_log2f_p[4];
+    d  = fm_log2f_p[1]*x + fm_log2f_p[2];
+    x4 = x2*x2;
+    a  = b*x2 + a;
+    c  = d*x2 + c;
+    x8 = x4*x4;
+    px = c*x4 + a;
+    px = fm_log2f_p[0]*x8 + px;
+
+    z = x*x2*px - 0.5*x2 + x;
+    z *= FM_FLOAT_LOG2OFE;
+    return ((float)ipart) + z;
+}
+
 float fm_logf_alt(float x) 
 {
     ufi_t val;
@@ -378,6 +432,10 @@ float fm_log10f_alt(float x)
     return z;
 }
 
+/* the highest accuracy tiers, see log_tier.c */
+double fm_log2_p52(double x) __attribute__ ((alias("fm_log2_alt")));
+double fm_log_p52(double x) __attribute__ ((alias("fm_log_alt")));
+
 #if defined(LIBM_ALIAS) && !defined(USE_LOG_SPLINE)
 /* include aliases to the equivalent libm functions for use with LD_PRELOAD. */
 double log(double x) __attribute__ ((alias("fm_log_alt")));
@@ -0,0 +1,73 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* compact version of log(x) in double precision, for loops where the
+ * 64 kB spline table of fm_log() would not stay in the L1 cache.
+ *
+ * strategy:
+ *
+ * the argument is split into 2**ipart * fpart with fpart in
+ * [0.6875:1.375[ by subtracting an offset from its bit pattern, and
+ * the top 8 bits of the mantissa of the difference select one of 256
+ * cells. for each cell the table from genspline holds 1/c for the
+ * center c of the cell and log(c), so that
+ *   log(x) = ipart*log(2) + log(c) + log1p(r), r = (fpart - c)/c.
+ * |r| < 2**-8 and log1p(r) is approximated by its taylor series up to
+ * r**6. the table has 256 pairs of doubles, i.e. 4 kB, and the cells
+ * on both sides of 1.0 use c = 1.0 to avoid the cancellation between
+ * log(c) and log1p(r) for arguments close to 1.
+ */
+
+/* -ffast-math would otherwise combine the conversion of the exponent
+ * via the 2**52 shifter below into a no-op. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "log_compact_kernel.c"
+
+double fm_log_compact(double x)
+{
+    return fm_log_compact_inl(x);
+}
+
+FM_BATCH_DEF(double,fm_log_compact,fm_log_compact_inl)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
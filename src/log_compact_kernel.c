@@ -0,0 +1,112 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* static inline kernels of the compact table based logarithm. this
+ * file is included by log_compact.c and by log_tier.c for the 40 bit
+ * accuracy tiers, so that both share the 4 kB table. see log_compact.c
+ * for details.
+ */
+
+#include "log_compact_tbl.c"
+
+/* 2**52 + 2**11, see log_poly_kernel.c */
+#define FM_DOUBLE_EXPCVT_BITS 0x4330000000000800ULL
+#define FM_DOUBLE_EXPCVT      4503599627372544.0
+
+static inline double fm_log_compact_inl(double x)
+{
+    udi_t val, ival, cval;
+    double r, r2, p, ipart, invc, logc;
+    uint64_t tmp;
+    int i;
+
+    val.f = x;
+    tmp = val.u - FM_LOG_COMPACT_OFF;
+    i = (int) ((tmp >> (52 - FM_LOG_COMPACT_BITS))
+               & ((1 << FM_LOG_COMPACT_BITS) - 1));
+    ival.u = FM_DOUBLE_EXPCVT_BITS ^ (tmp >> 52);
+    ipart = ival.f - FM_DOUBLE_EXPCVT;
+    val.u -= tmp & 0xfff0000000000000ULL;
+
+    /* the center of the cell has only 10 significant bits, so that
+       fpart - c is exact and r has a small relative error */
+    cval.u = (val.u & ~((1ULL << (52 - FM_LOG_COMPACT_BITS)) - 1))
+        | (1ULL << (51 - FM_LOG_COMPACT_BITS));
+    invc = fm_log_compact_tbl[2*i];
+    logc = fm_log_compact_tbl[2*i+1];
+    cval.f = (invc == 1.0) ? 1.0 : cval.f;
+    r = (val.f - cval.f) * invc;
+    r2 = r*r;
+
+    p = FM_FMA(r, 0.2, -0.25) - r2*(1.0/6.0);
+    p = FM_FMA(r, 1.0/3.0, -0.5) + r2*p;
+    p = FM_FMA(ipart, FM_DOUBLE_LOGEOF2_LO, r2*p);
+    return FM_FMA(ipart, FM_DOUBLE_LOGEOF2_HI, logc) + (r + p);
+}
+
+/* kernel of the 40 bit accuracy tiers in log_tier.c. with |r| <= 2**-8 the taylor
+   series of log1p(r) up to r**5 has a relative error below 2**-42,
+   which replaces the degree 14 polynomial a table free version needs.
+   returns log(fpart) and stores the exponent in *ipart. */
+static inline double fm_log_p40_kernel(double x, double *ipart)
+{
+    udi_t val, ival, cval;
+    double r, r2, p, invc, logc;
+    uint64_t tmp;
+    int i;
+
+    val.f = x;
+    tmp = val.u - FM_LOG_COMPACT_OFF;
+    i = (int) ((tmp >> (52 - FM_LOG_COMPACT_BITS))
+               & ((1 << FM_LOG_COMPACT_BITS) - 1));
+    ival.u = FM_DOUBLE_EXPCVT_BITS ^ (tmp >> 52);
+    *ipart = ival.f - FM_DOUBLE_EXPCVT;
+    val.u -= tmp & 0xfff0000000000000ULL;
+
+    cval.u = (val.u & ~((1ULL << (52 - FM_LOG_COMPACT_BITS)) - 1))
+        | (1ULL << (51 - FM_LOG_COMPACT_BITS));
+    invc = fm_log_compact_tbl[2*i];
+    logc = fm_log_compact_tbl[2*i+1];
+    cval.f = (invc == 1.0) ? 1.0 : cval.f;
+    r = (val.f - cval.f) * invc;
+    r2 = r*r;
+
+    p = FM_FMA(r, 1.0/3.0, -0.5) + r2*FM_FMA(r, 0.2, -0.25);
+    return logc + FM_FMA(r2, p, r);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
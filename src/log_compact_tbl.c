@@ -0,0 +1,290 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#define FM_LOG_COMPACT_BITS 8
+#define FM_LOG_COMPACT_OFF  0x3fe6000000000000ULL
+/* pairs of 1/c, log(c) */
+static const double fm_log_compact_tbl[] __attribute__ ((aligned(64))) = {
+ 1.45248226950354619724e+00, -3.73274002787184422392e-01,
+ 1.44837340876944842272e+00, -3.70441139702880339879e-01,
+ 1.44428772919605075131e+00, -3.67616279067325579799e-01,
+ 1.44022503516174404936e+00, -3.64799375796212244083e-01,
+ 1.43618513323983165719e+00, -3.61990385185157137471e-01,
+ 1.43216783216783216659e+00, -3.59189262905445449992e-01,
+ 1.42817294281729423311e+00, -3.56395964999832726150e-01,
+ 1.42420027816411676191e+00, -3.53610447878406397582e-01,
+ 1.42024965325936203264e+00, -3.50832668314503992590e-01,
+ 1.41632088520055332559e+00, -3.48062583440688411152e-01,
+ 1.41241379310344816744e+00, -3.45300150744778322487e-01,
+ 1.40852819807427787069e+00, -3.42545328065933740724e-01,
+ 1.40466392318244159831e+00, -3.39798073590794946774e-01,
+ 1.40082079343365251134e+00, -3.37058345849674589889e-01,
+ 1.39699863574351978990e+00, -3.34326103712801581125e-01,
+ 1.39319727891156452948e+00, -3.31601306386616445643e-01,
+ 1.38941655359565796601e+00, -3.28883913410116468512e-01,
+ 1.38565629228687425822e+00, -3.26173884651251300149e-01,
+ 1.38191632928475027775e+00, -3.23471180303366190323e-01,
+ 1.37819650067294752205e+00, -3.20775760881693905446e-01,
+ 1.37449664429530193921e+00, -3.18087587219893552781e-01,
+ 1.37081659973226233085e+00, -3.15406620466635811972e-01,
+ 1.36715620827770356627e+00, -3.12732822082233630212e-01,
+ 1.36351531291611194341e+00, -3.10066153835318325527e-01,
+ 1.35989375830013270452e+00, -3.07406577799559543873e-01,
+ 1.35629139072847682002e+00, -3.04754056350428403910e-01,
+ 1.35270805812417438396e+00, -3.02108552162004329045e-01,
+ 1.34914361001317528732e+00, -2.99470028203823179780e-01,
+ 1.34559789750328517854e+00, -2.96838447737767241463e-01,
+ 1.34207077326343382495e+00, -2.94213774314996068249e-01,
+ 1.33856209150326788127e+00, -2.91595971772917239573e-01,
+ 1.33507170795306384647e+00, -2.88985004232196918128e-01,
+ 1.33159947984395321541e+00, -2.86380836093809099108e-01,
+ 1.32814526588845649435e+00, -2.83783432036123606235e-01,
+ 1.32470892626131964143e+00, -2.81192757012031113728e-01,
+ 1.32129032258064516014e+00, -2.78608776246106082386e-01,
+ 1.31788931788931784617e+00, -2.76031455231805666894e-01,
+ 1.31450577663671364093e+00, -2.73460759728704816407e-01,
+ 1.31113956466069137008e+00, -2.70896655759767124305e-01,
+ 1.30779054916985959522e+00, -2.68339109608649983851e-01,
+ 1.30445859872611458208e+00, -2.65788087817044660355e-01,
+ 1.30114358322744605445e+00, -2.63243557182049892074e-01,
+ 1.29784537389100118610e+00, -2.60705484753578853319e-01,
+ 1.29456384323640971701e+00, -2.58173837831799202203e-01,
+ 1.29129886506935687152e+00, -2.55648583964605102814e-01,
+ 1.28805031446540874107e+00, -2.53129690945121166301e-01,
+ 1.28481806775407769727e+00, -2.50617126809238033314e-01,
+ 1.28160200250312894532e+00, -2.48110859833178432066e-01,
+ 1.27840199750312111249e+00, -2.45610858531093878554e-01,
+ 1.27521793275217931729e+00, -2.43117091652691408310e-01,
+ 1.27204968944099383599e+00, -2.40629528180889729061e-01,
+ 1.26889714993804214593e+00, -2.38148137329504294701e-01,
+ 1.26576019777503079311e+00, -2.35672888540961411596e-01,
+ 1.26263871763255242087e+00, -2.33203751484040183728e-01,
+ 1.25953259532595329695e+00, -2.30740696051642490971e-01,
+ 1.25644171779141111678e+00, -2.28283692358590389881e-01,
+ 1.25336597307221531139e+00, -2.25832710739450215343e-01,
+ 1.25030525030525030417e+00, -2.23387721746383660637e-01,
+ 1.24725943970767350066e+00, -2.20948696147024864489e-01,
+ 1.24422843256379089816e+00, -2.18515604922383283037e-01,
+ 1.24121212121212121104e+00, -2.16088419264772096939e-01,
+ 1.23821039903264806803e+00, -2.13667110575761792779e-01,
+ 1.23522316043425806065e+00, -2.11251650464158113873e-01,
+ 1.23225030084235864791e+00, -2.08842010744004907830e-01,
+ 1.22929171668667458484e+00, -2.06438163432610399806e-01,
+ 1.22634730538922154253e+00, -2.04040080748597613125e-01,
+ 1.22341696535244914834e+00, -2.01647735109977771506e-01,
+ 1.22050059594755655468e+00, -1.99261099132246904952e-01,
+ 1.21759809750297254283e+00, -1.96880145626505048684e-01,
+ 1.21470937129300127211e+00, -1.94504847597597646525e-01,
+ 1.21183431952662723496e+00, -1.92135178242279242022e-01,
+ 1.20897284533648163851e+00, -1.89771110947398707891e-01,
+ 1.20612485276796221889e+00, -1.87412619288105791737e-01,
+ 1.20329024676850759867e+00, -1.85059677026078950313e-01,
+ 1.20046893317702219051e+00, -1.82712258107773972693e-01,
+ 1.19766081871345031473e+00, -1.80370336662692865026e-01,
+ 1.19486581096849464600e+00, -1.78033887001673302164e-01,
+ 1.19208381839348076525e+00, -1.75702883615197730238e-01,
+ 1.18931475029036004543e+00, -1.73377301171722286721e-01,
+ 1.18655851680185397967e+00, -1.71057114516025149387e-01,
+ 1.18381502890173417875e+00, -1.68742298667573759063e-01,
+ 1.18108419838523648338e+00, -1.66432828818911249247e-01,
+ 1.17836593785960874747e+00, -1.64128680334061055612e-01,
+ 1.17566016073478762927e+00, -1.61829828746950288298e-01,
+ 1.17296678121420394625e+00, -1.59536249759850895513e-01,
+ 1.17028571428571437352e+00, -1.57247919241838673976e-01,
+ 1.16761687571265682095e+00, -1.54964813227270042928e-01,
+ 1.16496018202502837902e+00, -1.52686907914276109866e-01,
+ 1.16231555051078316865e+00, -1.50414179663273583909e-01,
+ 1.15968289920724809683e+00, -1.48146604995493091916e-01,
+ 1.15706214689265540763e+00, -1.45884160591523565076e-01,
+ 1.15445321307779025233e+00, -1.43626823289873611911e-01,
+ 1.15185601799775039211e+00, -1.41374570085548517673e-01,
+ 1.14927048260381603484e+00, -1.39127378128643786059e-01,
+ 1.14669652855543113823e+00, -1.36885224722954057519e-01,
+ 1.14413407821229040628e+00, -1.34648087324597737213e-01,
+ 1.14158305462653286710e+00, -1.32415943540656971811e-01,
+ 1.13904338153503892350e+00, -1.30188771127832808583e-01,
+ 1.13651498335183132049e+00, -1.27966547991115175975e-01,
+ 1.13399778516057581079e+00, -1.25749252182467685657e-01,
+ 1.13149171270718240656e+00, -1.23536861899526978492e-01,
+ 1.12899669239250277641e+00, -1.21329355484316489533e-01,
+ 1.12651265126512645232e+00, -1.19126711421974257332e-01,
+ 1.12403951701427007315e+00, -1.16928908339494777580e-01,
+ 1.12157721796276010906e+00, -1.14735925004484623502e-01,
+ 1.11912568306010928865e+00, -1.12547740323931777517e-01,
+ 1.11668484187568162191e+00, -1.10364333342988243936e-01,
+ 1.11425462459194779541e+00, -1.08185683243766039840e-01,
+ 1.11183496199782849700e+00, -1.06011769344146244975e-01,
+ 1.10942578548212344991e+00, -1.03842571096600930214e-01,
+ 1.10702702702702704407e+00, -1.01678068087027895228e-01,
+ 1.10463861920172590203e+00, -9.95182400335979377992e-02,
+ 1.10226049515608170992e+00, -9.73630667856145715078e-02,
+ 1.09989258861439309634e+00, -9.52125283223860252590e-02,
+ 1.09753483386923900156e+00, -9.30666047521092748562e-02,
+ 1.09518716577540109469e+00, -9.09252763107660927355e-02,
+ 1.09284951974386346230e+00, -8.87885233610309076990e-02,
+ 1.09052183173588934650e+00, -8.66563263911901832115e-02,
+ 1.08820403825717315627e+00, -8.45286660140734530389e-02,
+ 1.08589607635206797376e+00, -8.24055229659955978949e-02,
+ 1.08359788359788367096e+00, -8.02868781057103353405e-02,
+ 1.08130939809926074346e+00, -7.81727124133748535462e-02,
+ 1.07903055848261320016e+00, -7.60630069895252280965e-02,
+ 1.07676130389064139692e+00, -7.39577430540627883682e-02,
+ 1.07450157397691503647e+00, -7.18569019452509755164e-02,
+ 1.07225130890052366972e+00, -6.97604651187228447240e-02,
+ 1.07001044932079425465e+00, -6.76684141464988370140e-02,
+ 1.06777893639207510645e+00, -6.55807307160148761360e-02,
+ 1.06555671175858490685e+00, -6.34973966291605962375e-02,
+ 1.06334371754932499599e+00, -6.14183938013275407264e-02,
+ 1.06113989637305694558e+00, -5.93437042604671657897e-02,
+ 1.05894519131334030604e+00, -5.72733101461587665315e-02,
+ 1.05675954592363252615e+00, -5.52071937086868608224e-02,
+ 1.05458290422245104523e+00, -5.31453373081281835177e-02,
+ 1.05241521068859200660e+00, -5.10877234134480343042e-02,
+ 1.05025641025641025550e+00, -4.90343346016059167258e-02,
+ 1.04810644831115662434e+00, -4.69851535566703504276e-02,
+ 1.04596527068437183949e+00, -4.49401630689427109000e-02,
+ 1.04383282364933749342e+00, -4.28993460340900134575e-02,
+ 1.04170905391658186190e+00, -4.08626854522865443076e-02,
+ 1.03959390862944167644e+00, -3.88301644273642138083e-02,
+ 1.03748733535967585517e+00, -3.68017661659715139555e-02,
+ 1.03538928210313452283e+00, -3.47774739767409829527e-02,
+ 1.03329969727547932301e+00, -3.27572712694651074772e-02,
+ 1.03121852970795568893e+00, -3.07411415542805030454e-02,
+ 1.02914572864321618439e+00, -2.87290684408603239075e-02,
+ 1.02708124373119358275e+00, -2.67210356376147636914e-02,
+ 1.02502502502502501613e+00, -2.47170269508995739394e-02,
+ 1.02297702297702297614e+00, -2.27170262842325103303e-02,
+ 1.02093718843469583035e+00, -2.07210176375175643415e-02,
+ 1.01890547263681585655e+00, -1.87289851062769699408e-02,
+ 1.01688182720953324001e+00, -1.67409128808908014285e-02,
+ 1.01486620416253714438e+00, -1.47567852458441381436e-02,
+ 1.01285855588526207960e+00, -1.27765865789816780718e-02,
+ 1.01085883514313912279e+00, -1.08003013507697136208e-02,
+ 1.00886699507389154817e+00, -8.82791412356538802986e-03,
+ 1.00688298918387419967e+00, -6.85940955089314307463e-03,
+ 1.00490677134445527408e+00, -4.89477237672828087434e-03,
+ 1.00293829578844273520e+00, -2.93398743478753831759e-03,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 1.00000000000000000000e+00,  0.00000000000000000000e+00,
+ 9.94174757281553356236e-01,  5.84227562422836091405e-03,
+ 9.90328820116054164835e-01,  9.71824946892134618193e-03,
+ 9.86512524084778408273e-01,  1.35792581263808539993e-02,
+ 9.82725527831094014530e-01,  1.74254167138591341268e-02,
+ 9.78967495219885242008e-01,  2.12568390254151175223e-02,
+ 9.75238095238095237249e-01,  2.50736375521159599034e-02,
+ 9.71537001897533225581e-01,  2.88759235018545418194e-02,
+ 9.67863894139886604684e-01,  3.26638068187915936447e-02,
+ 9.64218455743879432340e-01,  3.64373962024310479868e-02,
+ 9.60600375234521575152e-01,  4.01967991263367518950e-02,
+ 9.57009345794392563000e-01,  4.39421218564987614563e-02,
+ 9.53445065176908745919e-01,  4.76734694693569036050e-02,
+ 9.49907235621521350843e-01,  5.13909458694893697683e-02,
+ 9.46395563770794812086e-01,  5.50946538069737382082e-02,
+ 9.42909760589318635127e-01,  5.87846948944276553872e-02,
+ 9.39449541284403721875e-01,  6.24611696237362887252e-02,
+ 9.36014625228519192568e-01,  6.61241773824734202503e-02,
+ 9.32604735883424407206e-01,  6.97738164700228424842e-02,
+ 9.29219600725952776799e-01,  7.34101841134067040207e-02,
+ 9.25858951175406841294e-01,  7.70333764828270151082e-02,
+ 9.22522522522522536725e-01,  8.06434887069267247739e-02,
+ 9.19210053859964126843e-01,  8.42406148877762328553e-02,
+ 9.15921288014311274495e-01,  8.78248481155913807150e-02,
+ 9.12655971479500838228e-01,  9.13962804831885272661e-02,
+ 9.09413854351687422906e-01,  9.49550031001825944887e-02,
+ 9.06194690265486713088e-01,  9.85011061069331617102e-02,
+ 9.02998236331569614777e-01,  1.02034678688244284661e-01,
+ 8.99824253075571123262e-01,  1.05555809086823132459e-01,
+ 8.96672504378283719007e-01,  1.09064584616502438519e-01,
+ 8.93542757417102984085e-01,  1.12561091675231775278e-01,
+ 8.90434782608695685191e-01,  1.16045415757842648730e-01,
+ 8.87348353552859570037e-01,  1.19517641468591770404e-01,
+ 8.84283246977547454648e-01,  1.22977852533487461151e-01,
+ 8.81239242685025847557e-01,  1.26426131812403447219e-01,
+ 8.78216123499142353737e-01,  1.29862561310984586660e-01,
+ 8.75213675213675212916e-01,  1.33287222192348703276e-01,
+ 8.72231686541737660789e-01,  1.36700194788588663686e-01,
+ 8.69269949066213909461e-01,  1.40101558612078930244e-01,
+ 8.66328257191201323018e-01,  1.43491392366590420071e-01,
+ 8.63406408094435029454e-01,  1.46869773958217680887e-01,
+ 8.60504201680672320407e-01,  1.50236780506121964107e-01,
+ 8.57621440536013412981e-01,  1.53592488353094303033e-01,
+ 8.54757929883138589666e-01,  1.56936973075941565980e-01,
+ 8.51913477537437624498e-01,  1.60270309495699786462e-01,
+ 8.49087893864013287804e-01,  1.63592571687677657000e-01,
+ 8.46280991735537169163e-01,  1.66903832991333683777e-01,
+ 8.43492586490939055821e-01,  1.70204166019990471570e-01,
+ 8.40722495894909660485e-01,  1.73493642670389247584e-01,
+ 8.37970540098199712098e-01,  1.76772334132087538539e-01,
+ 8.35236541598694981481e-01,  1.80040310896703609211e-01,
+ 8.32520325203252031798e-01,  1.83297642767010077192e-01,
+ 8.29821717990275486976e-01,  1.86544398865880034499e-01,
+ 8.27140549273021052912e-01,  1.89780647645088312858e-01,
+ 8.24476650563607083022e-01,  1.93006456893970973487e-01,
+ 8.21829855537720699310e-01,  1.96221893747945352882e-01,
+ 8.19200000000000039257e-01,  1.99427024696893717692e-01,
+ 8.16586921850079749952e-01,  2.02621915593412915690e-01,
+ 8.13990461049284630413e-01,  2.05806631660932742856e-01,
+ 8.11410459587955656957e-01,  2.08981237501705385817e-01,
+ 8.08846761453396512209e-01,  2.12145797104668409894e-01,
+ 8.06299212598425185661e-01,  2.15300373853183873996e-01,
+ 8.03767660910518100259e-01,  2.18445030532655570799e-01,
+ 8.01251956181533664392e-01,  2.21579829338027028962e-01,
+ 7.98751950078003147837e-01,  2.24704831881162248042e-01,
+ 7.96267496111975114914e-01,  2.27820099198111608585e-01,
+ 7.93798449612403089759e-01,  2.30925691756264706012e-01,
+ 7.91344667697063353096e-01,  2.34021669461392772815e-01,
+ 7.88906009244992323381e-01,  2.37108091664582215641e-01,
+ 7.86482334869431642943e-01,  2.40185017169061459930e-01,
+ 7.84073506891271088115e-01,  2.43252504236923267067e-01,
+ 7.81679389312977090931e-01,  2.46310610595744133855e-01,
+ 7.79299847792998434670e-01,  2.49359393445102717202e-01,
+ 7.76934749620637354894e-01,  2.52398909462999421205e-01,
+ 7.74583963691376720107e-01,  2.55429214812178506655e-01,
+ 7.72247360482654632285e-01,  2.58450365146354721357e-01,
+ 7.69924812030075234048e-01,  2.61462415616346366409e-01,
+ 7.67616191904047950878e-01,  2.64465420876115908655e-01,
+ 7.65321375186846064587e-01,  2.67459435088720665075e-01,
+ 7.63040238450074514986e-01,  2.70444511932174003199e-01,
+ 7.60772659732540823541e-01,  2.73420704605219999639e-01,
+ 7.58518518518518480853e-01,  2.76388065833022056328e-01,
+ 7.56277695716395914616e-01,  2.79346647872767195331e-01,
+ 7.54050073637702489293e-01,  2.82296502519188363678e-01,
+ 7.51835535976505098255e-01,  2.85237681110004581697e-01,
+ 7.49633967789165467366e-01,  2.88170234531282265511e-01,
+ 7.47445255474452507904e-01,  2.91094213222717501655e-01,
+ 7.45269286754002946438e-01,  2.94009667182841549771e-01,
+ 7.43105950653120461702e-01,  2.96916645974150794629e-01,
+ 7.40955137481910219854e-01,  2.99815198728162091157e-01,
+ 7.38816738816738816098e-01,  3.02705374150395445376e-01,
+ 7.36690647482014404623e-01,  3.05587220525284364303e-01,
+ 7.34576757532281243712e-01,  3.08460785721016095273e-01,
+ 7.32474964234620884440e-01,  3.11326117194302476321e-01,
+ 7.30385164051355229020e-01,  3.14183261995082285800e-01,
+ 7.28307254623044131314e-01,  3.17032266771157145158e-01
+};
@@ -0,0 +1,166 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* logarithms of unsigned integers, log(n) and n*log(n), for entropy
+ * and combinatorics, where the same small counts are used over and
+ * over again.
+ *
+ * strategy:
+ *
+ * for n < 2**16 the result is looked up from a table of log(n), which
+ * is shared by all threads and built on first use under the protection
+ * of pthread_once(). once it is built, a flag read with an acquire load
+ * lets the calls skip pthread_once(). larger values are converted to
+ * double precision and computed with the kernel of fm_log_v() in both
+ * the scalar and the batch functions. log(0) is -infinity, but
+ * 0*log(0) is taken to be 0 as is customary for entropies.
+ */
+
+/* -ffast-math would otherwise combine the conversion of the exponent
+ * in the log kernel via the 2**52 shifter into a no-op. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include <pthread.h>
+
+#include "log_poly_kernel.c"
+
+#define FM_LOG_INT_BITS 16
+#define FM_LOG_INT_SIZE (1U << FM_LOG_INT_BITS)
+
+static double fm_log_int_tbl[FM_LOG_INT_SIZE] __attribute__ ((aligned(64)));
+static pthread_once_t fm_log_int_once = PTHREAD_ONCE_INIT;
+static int fm_log_int_ready = 0;
+
+static void fm_log_int_init(void)
+{
+    udi_t val;
+    uint32_t n;
+
+    val.u = 0xfff0000000000000ULL;
+    fm_log_int_tbl[0] = val.f;
+    for (n = 1; n < FM_LOG_INT_SIZE; ++n)
+        fm_log_int_tbl[n] = fm_log_poly_inl((double) n);
+    __atomic_store_n(&fm_log_int_ready, 1, __ATOMIC_RELEASE);
+}
+
+/* the acquire load pairs with the release store at the end of
+ * fm_log_int_init(), so the table is complete when the flag is set. */
+static inline void fm_log_int_check(void)
+{
+    if (__builtin_expect(!__atomic_load_n(&fm_log_int_ready,
+                                          __ATOMIC_ACQUIRE), 0))
+        pthread_once(&fm_log_int_once, fm_log_int_init);
+}
+
+double fm_log_u32(uint32_t n)
+{
+    fm_log_int_check();
+    if (n < FM_LOG_INT_SIZE) return fm_log_int_tbl[n];
+    return fm_log_poly_inl((double) n);
+}
+
+double fm_nlogn_u32(uint32_t n)
+{
+    fm_log_int_check();
+    if (n < FM_LOG_INT_SIZE) return (n == 0) ? 0.0 : n * fm_log_int_tbl[n];
+    return n * fm_log_poly_inl((double) n);
+}
+
+/* the batch functions check each block of input for values outside of
+ * the table first, so that the common case is a plain gather loop over
+ * the table and the polynomial is only evaluated for blocks that need
+ * it. the table index is converted to a signed int, which is what
+ * the gather instructions take. the results are collected in a buffer
+ * on the stack, since the compiler can otherwise not prove, that the
+ * stores to y do not modify the table, and does not vectorize the
+ * loops. */
+
+void fm_log_u32_v(const uint32_t *n, double *y, size_t num)
+{
+    double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN)));
+    size_t i, j, m;
+    uint32_t k, big;
+
+    fm_log_int_check();
+    for (i = 0; i < num; i += m) {
+        m = (num - i < FM_BATCH_BLOCK) ? num - i : FM_BATCH_BLOCK;
+        for (j = 0, big = 0; j < m; ++j) big |= n[i+j];
+        if (big < FM_LOG_INT_SIZE) {
+            for (j = 0; j < m; ++j) buf[j] = fm_log_int_tbl[(int) n[i+j]];
+        } else {
+            for (j = 0; j < m; ++j) {
+                k = n[i+j];
+                buf[j] = (k < FM_LOG_INT_SIZE) ? fm_log_int_tbl[(int) k]
+                    : fm_log_poly_inl((double) k);
+            }
+        }
+        for (j = 0; j < m; ++j) y[i+j] = buf[j];
+    }
+}
+
+void fm_nlogn_u32_v(const uint32_t *n, double *y, size_t num)
+{
+    double buf[FM_BATCH_BLOCK] __attribute__ ((aligned(_FM_ALIGN)));
+    size_t i, j, m;
+    uint32_t k, big;
+
+    fm_log_int_check();
+    for (i = 0; i < num; i += m) {
+        m = (num - i < FM_BATCH_BLOCK) ? num - i : FM_BATCH_BLOCK;
+        for (j = 0, big = 0; j < m; ++j) big |= n[i+j];
+        if (big < FM_LOG_INT_SIZE) {
+            for (j = 0; j < m; ++j) buf[j] = fm_log_int_tbl[(int) n[i+j]];
+        } else {
+            for (j = 0; j < m; ++j) {
+                k = n[i+j];
+                buf[j] = (k < FM_LOG_INT_SIZE) ? fm_log_int_tbl[(int) k]
+                    : fm_log_poly_inl((double) k);
+            }
+        }
+        for (j = 0; j < m; ++j) {
+            k = n[i+j];
+            y[i+j] = (k == 0) ? 0.0 : k * buf[j];
+        }
+    }
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
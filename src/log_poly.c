@@ -0,0 +1,101 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* division free and table free versions of log_2(x), log(x) and
+ * log_10(x) in double precision.
+ *
+ * strategy:
+ *
+ * split the argument into a product, 2**ipart * fpart with fpart in
+ * [sqrt(0.5):sqrt(2)[ without a branch, as in log_tier.c, and
+ * approximate log(1+x) = x*p(x) for x = fpart-1 with a degree 20
+ * minimax polynomial from genpoly. p(x) is evaluated as the sum of
+ * its even and odd parts in x*x, which halves the chain of dependent
+ * multiply-adds.
+ *
+ * compared to the spline in log.c there are no table lookups (which
+ * become gathers in vector code) and compared to the rational function
+ * in log_alt.c there is no division and no branch. the batch versions
+ * are vectorized by the compiler.
+ */
+
+/* -ffast-math would otherwise combine the conversion of the exponent
+ * via the 2**52 shifter below into a no-op. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "log_poly_kernel.c"
+
+double fm_log2_poly(double x)
+{
+    return fm_log2_poly_inl(x);
+}
+
+double fm_log_poly(double x)
+{
+    return fm_log_poly_inl(x);
+}
+
+double fm_log10_poly(double x)
+{
+    return fm_log10_poly_inl(x);
+}
+
+FM_BATCH_DEF(double,fm_log2_poly,fm_log2_poly_inl)
+FM_BATCH_DEF(double,fm_log_poly,fm_log_poly_inl)
+FM_BATCH_DEF(double,fm_log10_poly,fm_log10_poly_inl)
+
+/* the batch versions of the default functions use the same kernels,
+ * since they vectorize best. */
+FM_BATCH_DEF(double,fm_log2,fm_log2_poly_inl)
+FM_BATCH_DEF(double,fm_log,fm_log_poly_inl)
+FM_BATCH_DEF(double,fm_log10,fm_log10_poly_inl)
+
+FM_BATCH_STREAM_DEF(fm_log2,fm_log2_poly_inl)
+FM_BATCH_STREAM_DEF(fm_log,fm_log_poly_inl)
+FM_BATCH_STREAM_DEF(fm_log10,fm_log10_poly_inl)
+
+FM_BATCH_STRIDED_DEF(fm_log,fm_log_poly_inl)
+FM_BATCH_IDX_DEF(fm_log,fm_log_poly_inl)
+FM_BATCH_MASK_DEF(fm_log,fm_log_poly_inl)
+FM_BATCH_AXPBY_DEF(fm_log,fm_log_poly_inl)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
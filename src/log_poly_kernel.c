@@ -0,0 +1,142 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* static inline kernels of the division free log_2(x), log(x) and log_10(x)
+ * functions. this file is included by log_poly.c and omp.c, so that
+ * the batch loops in both can inline them. see log_poly.c for details.
+ */
+
+/* minimax polynomial for log1p(x) in [-0.292893:0.414214], degree 20,
+   max rel err 1.5e-16 (52.6 bits) */
+static const double fm_log_poly_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 2.61389846110262231982e-02,
+-6.00557796353844014492e-02,
+ 6.53383828455492837728e-02,
+-5.67996866583667450734e-02,
+ 5.65782534326702765681e-02,
+-6.19368616110958225551e-02,
+ 6.68605738847160013805e-02,
+-7.15004606194176023370e-02,
+ 7.69142858046524269255e-02,
+-8.33285456063443397134e-02,
+ 9.09092726219083019368e-02,
+-1.00000184317487944563e-01,
+ 1.11111111223683250993e-01,
+-1.24999995893823309667e-01,
+ 1.42857142787431001807e-01,
+-1.66666666716169281637e-01,
+ 2.00000000001002126160e-01,
+-2.49999999999726885136e-01,
+ 3.33333333333329151493e-01,
+-5.00000000000000444089e-01,
+ 1.00000000000000000000e+00
+};
+
+/* 2**52 + 2**11. adding the biased exponent in the mantissa bits
+ * and subtracting this as a double converts it to a floating point
+ * number without a (64-bit) integer conversion instruction. */
+#define FM_DOUBLE_EXPCVT_BITS 0x4330000000000800ULL
+#define FM_DOUBLE_EXPCVT      4503599627372544.0
+
+/* returns log(1+x) and the exponent in ipart */
+static inline double fm_log_poly_kernel(double x, double *ipart)
+{
+    udi_t val, ival;
+    double x2, e, o;
+    uint64_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_DOUBLE_SQRTH_BITS;
+    val.u -= tmp & 0xfff0000000000000ULL;
+    ival.u = FM_DOUBLE_EXPCVT_BITS ^ (tmp >> 52);
+    *ipart = ival.f - FM_DOUBLE_EXPCVT;
+    x = val.f - 1.0;
+    x2 = x*x;
+
+    e =        fm_log_poly_p[0];
+    o =        fm_log_poly_p[1];
+    e = e*x2 + fm_log_poly_p[2];
+    o = o*x2 + fm_log_poly_p[3];
+    e = e*x2 + fm_log_poly_p[4];
+    o = o*x2 + fm_log_poly_p[5];
+    e = e*x2 + fm_log_poly_p[6];
+    o = o*x2 + fm_log_poly_p[7];
+    e = e*x2 + fm_log_poly_p[8];
+    o = o*x2 + fm_log_poly_p[9];
+    e = e*x2 + fm_log_poly_p[10];
+    o = o*x2 + fm_log_poly_p[11];
+    e = e*x2 + fm_log_poly_p[12];
+    o = o*x2 + fm_log_poly_p[13];
+    e = e*x2 + fm_log_poly_p[14];
+    o = o*x2 + fm_log_poly_p[15];
+    e = e*x2 + fm_log_poly_p[16];
+    o = o*x2 + fm_log_poly_p[17];
+    e = e*x2 + fm_log_poly_p[18];
+    o = o*x2 + fm_log_poly_p[19];
+    e = e*x2 + fm_log_poly_p[20];
+
+    return x*(e + x*o);
+}
+
+static inline double fm_log2_poly_inl(double x)
+{
+    double ipart, y;
+
+    y = fm_log_poly_kernel(x, &ipart);
+    return FM_FMA(y, FM_DOUBLE_LOG2OFE, ipart);
+}
+
+static inline double fm_log_poly_inl(double x)
+{
+    double ipart, y;
+
+    y = fm_log_poly_kernel(x, &ipart);
+    y = FM_FMA(ipart, FM_DOUBLE_LOGEOF2_LO, y);
+    return FM_FMA(ipart, FM_DOUBLE_LOGEOF2_HI, y);
+}
+
+static inline double fm_log10_poly_inl(double x)
+{
+    double ipart, y;
+
+    y = fm_log_poly_kernel(x, &ipart);
+    y = FM_FMA(ipart, FM_DOUBLE_LOG10OF2_LO, y*FM_DOUBLE_LOG10OFE);
+    return FM_FMA(ipart, FM_DOUBLE_LOG10OF2_HI, y);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,351 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* graded accuracy variants of log_2(x) and log(x) in single and
+ * double precision.
+ *
+ * strategy:
+ *
+ * split the argument into a product, 2**ipart * fpart with fpart in
+ * [sqrt(0.5):sqrt(2)[ without a branch, by subtracting the bit pattern
+ * of sqrt(0.5) and using the exponent bits of the difference as ipart.
+ * then approximate log(1+x) = x*p(x) for x = fpart-1 with a minimax
+ * polynomial p(x) of the degree required by the accuracy tier.
+ * the coefficients have been computed with genpoly.
+ *
+ * unlike the spline tables, this keeps the relative error bounded for
+ * arguments close to 1.0. the function name suffix is the number of
+ * mantissa bits that are (at least) correct. the highest accuracy
+ * tiers of the double precision functions are aliases of the rational
+ * function approximations in log_alt.c. a polynomial over the whole
+ * interval would need degree 14 for 40 bits and be slower than fm_log(),
+ * so the 40 bit tiers use the table of fm_log_compact() instead.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "log_tier_kernel.c"
+
+/* minimax polynomial for log2p1(x) in [-0.2929:0.4143], degree 3,
+   max rel err 0.000351 (11.5 bits) */
+static const float fm_log2f_p11_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+-3.2773733139e-01f,
+ 5.1127386093e-01f,
+-7.2429960966e-01f,
+ 1.4422703981e+00f
+};
+
+float fm_log2f_p11(float x)
+{
+    ufi_t val;
+    float y;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    y =       fm_log2f_p11_p[0];
+    y = y*x + fm_log2f_p11_p[1];
+    y = y*x + fm_log2f_p11_p[2];
+    y = y*x + fm_log2f_p11_p[3];
+
+    return ((float) ipart) + x*y;
+}
+
+float fm_logf_p11(float x)
+{
+    ufi_t val;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    return ((float) ipart)*FM_FLOAT_LOGEOF2 + x*fm_logf_p11_kernel(x);
+}
+
+/* minimax polynomial for log2p1(x) in [-0.2929:0.4143], degree 5,
+   max rel err 7.478e-06 (17.0 bits) */
+static const float fm_log2f_p16_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+-2.0615728199e-01f,
+ 3.1819698215e-01f,
+-3.6649650335e-01f,
+ 4.7981202602e-01f,
+-7.2120624781e-01f,
+ 1.4427015781e+00f
+};
+
+float fm_log2f_p16(float x)
+{
+    ufi_t val;
+    float y;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    y =       fm_log2f_p16_p[0];
+    y = y*x + fm_log2f_p16_p[1];
+    y = y*x + fm_log2f_p16_p[2];
+    y = y*x + fm_log2f_p16_p[3];
+    y = y*x + fm_log2f_p16_p[4];
+    y = y*x + fm_log2f_p16_p[5];
+
+    return ((float) ipart) + x*y;
+}
+
+float fm_logf_p16(float x)
+{
+    ufi_t val;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    return ((float) ipart)*FM_FLOAT_LOGEOF2 + x*fm_logf_p16_kernel(x);
+}
+
+/* minimax polynomial for log2p1(x) in [-0.2929:0.4143], degree 8,
+   max rel err 1.137e-07 (23.1 bits) */
+static const float fm_log2f_p23_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 1.2580458820e-01f,
+-2.0726108551e-01f,
+ 2.1572238207e-01f,
+-2.3894622922e-01f,
+ 2.8791579604e-01f,
+-3.6070361733e-01f,
+ 4.8091065884e-01f,
+-7.2134733200e-01f,
+ 1.4426950216e+00f
+};
+
+float fm_log2f_p23(float x)
+{
+    ufi_t val;
+    float y;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    y =       fm_log2f_p23_p[0];
+    y = y*x + fm_log2f_p23_p[1];
+    y = y*x + fm_log2f_p23_p[2];
+    y = y*x + fm_log2f_p23_p[3];
+    y = y*x + fm_log2f_p23_p[4];
+    y = y*x + fm_log2f_p23_p[5];
+    y = y*x + fm_log2f_p23_p[6];
+    y = y*x + fm_log2f_p23_p[7];
+    y = y*x + fm_log2f_p23_p[8];
+
+    return ((float) ipart) + x*y;
+}
+
+/* minimax polynomial for log1p(x) in [-0.2929:0.4143], degree 8,
+   max rel err 1.193e-07 (23.0 bits) */
+static const float fm_logf_p23_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 8.7201103568e-02f,
+-1.4366243780e-01f,
+ 1.4952735603e-01f,
+-1.6562490165e-01f,
+ 1.9956801832e-01f,
+-2.5002068281e-01f,
+ 3.3334186673e-01f,
+-4.9999988079e-01f,
+ 1.0000000000e+00f
+};
+
+float fm_logf_p23(float x)
+{
+    ufi_t val;
+    float y;
+    int32_t ipart;
+    uint32_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_FLOAT_SQRTH_BITS;
+    ipart = ((int32_t) tmp) >> FM_FLOAT_MBITS;
+    val.u -= tmp & (~FM_FLOAT_MMASK);
+    x = val.f - 1.0f;
+
+    y =       fm_logf_p23_p[0];
+    y = y*x + fm_logf_p23_p[1];
+    y = y*x + fm_logf_p23_p[2];
+    y = y*x + fm_logf_p23_p[3];
+    y = y*x + fm_logf_p23_p[4];
+    y = y*x + fm_logf_p23_p[5];
+    y = y*x + fm_logf_p23_p[6];
+    y = y*x + fm_logf_p23_p[7];
+    y = y*x + fm_logf_p23_p[8];
+
+    return ((float) ipart)*FM_FLOAT_LOGEOF2 + x*y;
+}
+
+/* minimax polynomial for log2p1(x) in [-0.2929:0.4143], degree 8,
+   max rel err 2.617e-08 (25.2 bits) */
+static const double fm_log2_p24_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 1.25804594518614615284e-01,
+-2.07261082906119803448e-01,
+ 2.15722382232191978169e-01,
+-2.38946225516363242036e-01,
+ 2.87915784797082852098e-01,
+-3.60703620684345693803e-01,
+ 4.80910653536533505559e-01,
+-7.21347347437125474556e-01,
+ 1.44269500361356173279e+00
+};
+
+double fm_log2_p24(double x)
+{
+    udi_t val;
+    double y;
+    int32_t ipart;
+    uint64_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_DOUBLE_SQRTH_BITS;
+    ipart = (int32_t) (((int64_t) tmp) >> 52);
+    val.u -= tmp & 0xfff0000000000000ULL;
+    x = val.f - 1.0;
+
+    y =       fm_log2_p24_p[0];
+    y = y*x + fm_log2_p24_p[1];
+    y = y*x + fm_log2_p24_p[2];
+    y = y*x + fm_log2_p24_p[3];
+    y = y*x + fm_log2_p24_p[4];
+    y = y*x + fm_log2_p24_p[5];
+    y = y*x + fm_log2_p24_p[6];
+    y = y*x + fm_log2_p24_p[7];
+    y = y*x + fm_log2_p24_p[8];
+
+    return ((double) ipart) + x*y;
+}
+
+/* minimax polynomial for log1p(x) in [-0.2929:0.4143], degree 8,
+   max rel err 2.617e-08 (25.2 bits) */
+static const double fm_log_p24_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+ 8.72010999920350415859e-02,
+-1.43662435256167592135e-01,
+ 1.49527361027924937664e-01,
+-1.65624902522109873626e-01,
+ 1.99568014470801469162e-01,
+-2.50020697695118088166e-01,
+ 3.33341863600088883501e-01,
+-4.99999880080438774410e-01,
+ 9.99999974162660509869e-01
+};
+
+double fm_log_p24(double x)
+{
+    udi_t val;
+    double y;
+    int32_t ipart;
+    uint64_t tmp;
+
+    /* reduce to [sqrt(0.5):sqrt(2)[ and extract the exponent */
+    val.f = x;
+    tmp = val.u - FM_DOUBLE_SQRTH_BITS;
+    ipart = (int32_t) (((int64_t) tmp) >> 52);
+    val.u -= tmp & 0xfff0000000000000ULL;
+    x = val.f - 1.0;
+
+    y =       fm_log_p24_p[0];
+    y = y*x + fm_log_p24_p[1];
+    y = y*x + fm_log_p24_p[2];
+    y = y*x + fm_log_p24_p[3];
+    y = y*x + fm_log_p24_p[4];
+    y = y*x + fm_log_p24_p[5];
+    y = y*x + fm_log_p24_p[6];
+    y = y*x + fm_log_p24_p[7];
+    y = y*x + fm_log_p24_p[8];
+
+    return ((double) ipart)*FM_DOUBLE_LOGEOF2 + x*y;
+}
+
+/* -ffast-math would otherwise combine the conversion of the exponent
+ * via the 2**52 shifter in the kernel into a no-op. this only applies
+ * to the functions below. */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "log_compact_kernel.c"
+
+double fm_log_p40(double x)
+{
+    double ipart, y;
+
+    y = fm_log_p40_kernel(x, &ipart);
+    return FM_FMA(ipart, FM_DOUBLE_LOGEOF2, y);
+}
+
+double fm_log2_p40(double x)
+{
+    double ipart, y;
+
+    y = fm_log_p40_kernel(x, &ipart);
+    return FM_FMA(y, FM_DOUBLE_LOG2OFE, ipart);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
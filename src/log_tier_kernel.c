@@ -0,0 +1,91 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* static inline kernels of the 11 and 16 bit single precision tiers
+ * of log(x). this file is included by log_tier.c and half.c, so that
+ * both use the same coefficients. see log_tier.c for details.
+ */
+
+/* minimax polynomial for log1p(x) in [-0.2929:0.4143], degree 3,
+   max rel err 0.0003509 (11.5 bits) */
+static const float fm_logf_p11_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+-2.2717021406e-01f,
+ 3.5438802838e-01f,
+-5.0204622746e-01f,
+ 9.9970561266e-01f
+};
+
+/* p(x) with log(1+x) = x*p(x) for x in [sqrt(0.5)-1:sqrt(2)-1[ */
+static inline float fm_logf_p11_kernel(float x)
+{
+    float y;
+
+    y =       fm_logf_p11_p[0];
+    y = y*x + fm_logf_p11_p[1];
+    y = y*x + fm_logf_p11_p[2];
+    y = y*x + fm_logf_p11_p[3];
+
+    return y;
+}
+
+/* minimax polynomial for log1p(x) in [-0.2929:0.4143], degree 5,
+   max rel err 7.483e-06 (17.0 bits) */
+static const float fm_logf_p16_p[] __attribute__ ((aligned(_FM_ALIGN))) = {
+-1.4289733768e-01f,
+ 2.2055734694e-01f,
+-2.5403600931e-01f,
+ 3.3258035779e-01f,
+-4.9990206957e-01f,
+ 1.0000045300e+00f
+};
+
+/* p(x) with log(1+x) = x*p(x) for x in [sqrt(0.5)-1:sqrt(2)-1[ */
+static inline float fm_logf_p16_kernel(float x)
+{
+    float y;
+
+    y =       fm_logf_p16_p[0];
+    y = y*x + fm_logf_p16_p[1];
+    y = y*x + fm_logf_p16_p[2];
+    y = y*x + fm_logf_p16_p[3];
+    y = y*x + fm_logf_p16_p[4];
+    y = y*x + fm_logf_p16_p[5];
+
+    return y;
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
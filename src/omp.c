@@ -0,0 +1,75 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* batch functions for use inside OpenMP parallel regions.
+ *
+ * the loops contain only an orphaned worksharing construct, so when
+ * called from all threads of a parallel region, the elements are
+ * distributed across the existing team, and when called outside of
+ * a parallel region, they behave like the plain batch functions. no
+ * threads are created by the library. these functions are compiled
+ * into the separate libfastermath_omp library, so that the regular
+ * library does not depend on the OpenMP runtime.
+ */
+
+/* see exp_poly.c */
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC optimize ("no-associative-math")
+#endif
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include "exp_poly_kernel.c"
+#include "log_poly_kernel.c"
+
+#define FM_BATCH_OMP_DEF(name,kernel)                           \
+    void name ## _v_omp(const double *x, double *y, size_t n)   \
+    {                                                           \
+        size_t i;                                               \
+        _Pragma("omp for simd schedule(static)")                \
+        for (i = 0; i < n; ++i) y[i] = kernel(x[i]);            \
+    }
+
+FM_BATCH_OMP_DEF(fm_exp2,fm_exp2_poly_inl)
+FM_BATCH_OMP_DEF(fm_exp,fm_exp_poly_inl)
+FM_BATCH_OMP_DEF(fm_exp10,fm_exp10_poly_inl)
+FM_BATCH_OMP_DEF(fm_log2,fm_log2_poly_inl)
+FM_BATCH_OMP_DEF(fm_log,fm_log_poly_inl)
+FM_BATCH_OMP_DEF(fm_log10,fm_log10_poly_inl)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,161 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* sum of logarithms, i.e. the logarithm of a product, in single and
+ * double precision.
+ *
+ * strategy:
+ *
+ * the sum of log(x[i]) is the sum of the binary exponents of x[i]
+ * times log(2) plus the log of the product of their mantissas. the
+ * exponents are extracted with the same bit manipulation as in
+ * fm_log2() and accumulated as integers, the mantissas in [1.0:2.0[
+ * are multiplied in several independent lanes, which the compiler can
+ * map to vector registers. after each block of elements the lane
+ * products are folded into a running product, which is renormalized
+ * to [1.0:2.0[, so that it can neither overflow nor underflow. only a
+ * single logarithm is needed at the end.
+ *
+ * the arguments must be positive normalized numbers. the relative
+ * rounding error of the product grows with the number of elements, as
+ * does that of a sum of individual logarithms.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+/* number of independent products and elements per block. a lane
+ * multiplies at most FM_SUM_LOG_BLOCK/FM_SUM_LOG_LANES mantissas per
+ * block, i.e. 64 in double and 32 in single precision, so the
+ * product stays far below the largest representable number. */
+#define FM_SUM_LOG_LANES   8
+#define FM_SUM_LOGF_LANES 16
+#define FM_SUM_LOG_BLOCK 512
+
+/* multiply the mantissa of m into *p and move the exponent to *e */
+static inline void fm_sum_log_renorm(double *p, int64_t *e, double m)
+{
+    udi_t val;
+
+    val.f = *p * m;
+    *e += (int64_t) (val.u >> 52) - FM_DOUBLE_BIAS;
+    val.u = (val.u & FM_DOUBLE_MMASK64) | FM_DOUBLE_EZERO64;
+    *p = val.f;
+}
+
+double fm_sum_log(const double *x, size_t n)
+{
+    double m[FM_SUM_LOG_LANES] __attribute__ ((aligned(_FM_ALIGN)));
+    int64_t e[FM_SUM_LOG_LANES] __attribute__ ((aligned(_FM_ALIGN)));
+    double p = 1.0;
+    int64_t esum = 0;
+    udi_t val;
+    size_t i, j;
+    int k;
+
+    for (i = 0; i + FM_SUM_LOG_BLOCK <= n; i += FM_SUM_LOG_BLOCK) {
+        for (k = 0; k < FM_SUM_LOG_LANES; ++k) {
+            m[k] = 1.0;
+            e[k] = 0;
+        }
+        for (j = 0; j < FM_SUM_LOG_BLOCK; j += FM_SUM_LOG_LANES) {
+            for (k = 0; k < FM_SUM_LOG_LANES; ++k) {
+                val.f = x[i+j+k];
+                e[k] += (int64_t) (val.u >> 52);
+                val.u = (val.u & FM_DOUBLE_MMASK64) | FM_DOUBLE_EZERO64;
+                m[k] *= val.f;
+            }
+        }
+        for (k = 0; k < FM_SUM_LOG_LANES; ++k) {
+            esum += e[k];
+            fm_sum_log_renorm(&p, &esum, m[k]);
+        }
+        esum -= (int64_t) FM_DOUBLE_BIAS * FM_SUM_LOG_BLOCK;
+    }
+
+    /* remaining elements */
+    for (; i < n; ++i) {
+        val.f = x[i];
+        esum += (int64_t) (val.u >> 52) - FM_DOUBLE_BIAS;
+        val.u = (val.u & FM_DOUBLE_MMASK64) | FM_DOUBLE_EZERO64;
+        fm_sum_log_renorm(&p, &esum, val.f);
+    }
+
+    return fm_log(p) + FM_DOUBLE_LOGEOF2 * (double) esum;
+}
+
+float fm_sum_logf(const float *x, size_t n)
+{
+    float m[FM_SUM_LOGF_LANES] __attribute__ ((aligned(_FM_ALIGN)));
+    int32_t e[FM_SUM_LOGF_LANES] __attribute__ ((aligned(_FM_ALIGN)));
+    double p = 1.0;
+    int64_t esum = 0;
+    ufi_t val;
+    size_t i, j;
+    int k;
+
+    for (i = 0; i + FM_SUM_LOG_BLOCK <= n; i += FM_SUM_LOG_BLOCK) {
+        for (k = 0; k < FM_SUM_LOGF_LANES; ++k) {
+            m[k] = 1.0f;
+            e[k] = 0;
+        }
+        for (j = 0; j < FM_SUM_LOG_BLOCK; j += FM_SUM_LOGF_LANES) {
+            for (k = 0; k < FM_SUM_LOGF_LANES; ++k) {
+                val.f = x[i+j+k];
+                e[k] += (int32_t) (val.u >> FM_FLOAT_MBITS);
+                val.u = (val.u & FM_FLOAT_MMASK) | FM_FLOAT_EZERO;
+                m[k] *= val.f;
+            }
+        }
+        for (k = 0; k < FM_SUM_LOGF_LANES; ++k) {
+            esum += e[k];
+            fm_sum_log_renorm(&p, &esum, (double) m[k]);
+        }
+        esum -= (int64_t) FM_FLOAT_BIAS * FM_SUM_LOG_BLOCK;
+    }
+
+    for (; i < n; ++i) {
+        val.f = x[i];
+        esum += (int64_t) (val.u >> FM_FLOAT_MBITS) - FM_FLOAT_BIAS;
+        val.u = (val.u & FM_FLOAT_MMASK) | FM_FLOAT_EZERO;
+        fm_sum_log_renorm(&p, &esum, (double) val.f);
+    }
+
+    return (float) (fm_log(p) + FM_DOUBLE_LOGEOF2 * (double) esum);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -0,0 +1,262 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* cubic spline tables for arbitrary smooth functions, created at
+ * runtime.
+ *
+ * strategy:
+ *
+ * same as the spline tables for log() from genspline: the function is
+ * tabulated on a uniform grid with 2**bits intervals in [lo:hi] and
+ * the second derivatives of the interpolating natural cubic spline are
+ * computed by solving the tridiagonal system once. for each interval
+ * the two function values and the two second derivatives are stored
+ * next to each other in one 32 byte record, so that an evaluation
+ * needs one table index and touches one cache line. with AVX, the
+ * batch version loads one record per argument into a vector register
+ * and transposes four of them, instead of gathering each element.
+ *
+ * the scaled argument t is clamped to [0:n] in floating point before it
+ * is converted to an interval index, so that large arguments cannot
+ * overflow the int conversion. arguments outside of [lo:hi] are
+ * extrapolated linearly with the slope of the spline at the end of the
+ * table, which continues the natural spline (y'' = 0 at the ends) with
+ * a continuous second derivative. the integer clamp of the index only
+ * catches NaN arguments, which return NaN.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include <stdlib.h>
+
+struct fm_table
+{
+    double *rec;                /* y[i], y[i+1], y2[i], y2[i+1] per interval */
+    double lo, hi;              /* range of the table */
+    double dinv;                /* 1/delta */
+    double dsq6;                /* delta*delta/6 */
+    int n;                      /* number of intervals */
+};
+
+/* second derivatives of the natural cubic spline through the n points
+ * y on a grid with spacing delta, i.e. with y2[0] = y2[n-1] = 0.
+ * u is a work array of n elements. */
+static void fm_table_spline(double delta, const double *y, int n,
+                            double *y2, double *u)
+{
+    int i,k;
+    double p;
+
+    y2[0] = u[0] = 0.0;
+    for (i = 1; i < n-1; i++) {
+        p = 0.5*y2[i-1] + 2.0;
+        y2[i] = -0.5 / p;
+        u[i] = (y[i+1]-2.0*y[i]+y[i-1]) / delta;
+        u[i] = (3.0*u[i] / delta - 0.5*u[i-1]) / p;
+    }
+
+    y2[n-1] = 0.0;
+    for (k = n-2; k >= 0; k--) y2[k] = y2[k]*y2[k+1] + u[k];
+}
+
+fm_table *fm_table_create(double (*f)(double), double lo, double hi, int bits)
+{
+    fm_table *tbl;
+    double *y, *y2, *u, delta;
+    int i, n;
+
+    if ((f == NULL) || !(hi > lo) || (bits < 1) || (bits > 24))
+        return NULL;
+
+    n = 1 << bits;
+    tbl = (fm_table *) malloc(sizeof(fm_table));
+    y  = (double *) malloc((n+1)*sizeof(double));
+    y2 = (double *) malloc((n+1)*sizeof(double));
+    u  = (double *) malloc((n+1)*sizeof(double));
+    if ((tbl == NULL) || (y == NULL) || (y2 == NULL) || (u == NULL)
+        || posix_memalign((void **)&tbl->rec, 64, 4*n*sizeof(double))) {
+        free(tbl);
+        free(y);
+        free(y2);
+        free(u);
+        return NULL;
+    }
+
+    delta = (hi - lo) / n;
+    tbl->lo = lo;
+    tbl->hi = hi;
+    tbl->dinv = 1.0/delta;
+    tbl->dsq6 = delta*delta/6.0;
+    tbl->n = n;
+
+    for (i = 0; i <= n; ++i)
+        y[i] = f(lo + i*delta);
+    fm_table_spline(delta, y, n+1, y2, u);
+
+    for (i = 0; i < n; ++i) {
+        tbl->rec[4*i]   = y[i];
+        tbl->rec[4*i+1] = y[i+1];
+        tbl->rec[4*i+2] = y2[i];
+        tbl->rec[4*i+3] = y2[i+1];
+    }
+
+    free(y);
+    free(y2);
+    free(u);
+    return tbl;
+}
+
+void fm_table_free(fm_table *tbl)
+{
+    if (tbl) {
+        free(tbl->rec);
+        free(tbl);
+    }
+}
+
+static inline double fm_table_eval_inl(const double *rec, double lo,
+                                       double dinv, double dsq6,
+                                       int n, double x)
+{
+    double a, b, t, tc, y, s;
+    int i;
+
+    t = (x - lo) * dinv;
+    tc = (t > 0.0) ? t : 0.0;
+    tc = (tc < (double) n) ? tc : (double) n;
+    i = (int) tc;
+    i = (i < 0) ? 0 : ((i > n-1) ? n-1 : i);
+    b = tc - i;
+    a = 1.0 - b;
+    i *= 4;
+
+    y = a*rec[i] + b*rec[i+1]
+        + ((a*a*a-a)*rec[i+2] + (b*b*b-b)*rec[i+3]) * dsq6;
+
+    /* linear extrapolation with the slope at the clamped argument */
+    if (__builtin_expect(t != tc, 0)) {
+        s = rec[i+1] - rec[i]
+            + ((1.0-3.0*a*a)*rec[i+2] + (3.0*b*b-1.0)*rec[i+3]) * dsq6;
+        y += (t - tc)*s;
+    }
+    return y;
+}
+
+double fm_table_eval(const fm_table *tbl, double x)
+{
+    return fm_table_eval_inl(tbl->rec, tbl->lo, tbl->dinv, tbl->dsq6,
+                             tbl->n, x);
+}
+
+#if defined(__AVX__)
+/* evaluate four arguments at once. the four records are loaded with
+ * one aligned 32 byte load each and transposed in registers, which is
+ * much faster than four gathers of one element per record. */
+static inline __m256d fm_table_eval_avx(const double *rec, __m256d lo,
+                                        __m256d dinv, __m256d dsq6,
+                                        __m256d tmax, __m128i nmax,
+                                        __m256d x)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d three = _mm256_set1_pd(3.0);
+    __m256d t, tc, a, b, r0, r1, r2, r3, t0, t1, t2, t3, y0, y1, c0, c1;
+    __m128i i;
+
+    /* maxpd returns the second operand for NaN, so tc is never NaN */
+    t = _mm256_mul_pd(_mm256_sub_pd(x, lo), dinv);
+    tc = _mm256_min_pd(_mm256_max_pd(t, _mm256_setzero_pd()), tmax);
+    i = _mm256_cvttpd_epi32(tc);
+    i = _mm_min_epi32(_mm_max_epi32(i, _mm_setzero_si128()), nmax);
+    b = _mm256_sub_pd(tc, _mm256_cvtepi32_pd(i));
+    a = _mm256_sub_pd(one, b);
+
+    i = _mm_slli_epi32(i, 2);
+    r0 = _mm256_load_pd(rec + _mm_extract_epi32(i, 0));
+    r1 = _mm256_load_pd(rec + _mm_extract_epi32(i, 1));
+    r2 = _mm256_load_pd(rec + _mm_extract_epi32(i, 2));
+    r3 = _mm256_load_pd(rec + _mm_extract_epi32(i, 3));
+
+    t0 = _mm256_unpacklo_pd(r0, r1);
+    t1 = _mm256_unpackhi_pd(r0, r1);
+    t2 = _mm256_unpacklo_pd(r2, r3);
+    t3 = _mm256_unpackhi_pd(r2, r3);
+    y0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    y1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    c0 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    c1 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    t0 = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(a, a), a), a), c0);
+    t1 = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(b, b), b), b), c1);
+    t2 = _mm256_add_pd(_mm256_mul_pd(a, y0), _mm256_mul_pd(b, y1));
+    t2 = _mm256_add_pd(t2, _mm256_mul_pd(_mm256_add_pd(t0, t1), dsq6));
+
+    /* linear extrapolation with the slope at the clamped argument,
+     * only if an argument is outside of the table */
+    if (__builtin_expect(!_mm256_movemask_pd(_mm256_cmp_pd(t, tc, _CMP_NEQ_UQ)), 1))
+        return t2;
+    t0 = _mm256_mul_pd(_mm256_sub_pd(one, _mm256_mul_pd(three, _mm256_mul_pd(a, a))), c0);
+    t1 = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(three, _mm256_mul_pd(b, b)), one), c1);
+    t3 = _mm256_add_pd(_mm256_sub_pd(y1, y0),
+                       _mm256_mul_pd(_mm256_add_pd(t0, t1), dsq6));
+    return _mm256_add_pd(t2, _mm256_mul_pd(_mm256_sub_pd(t, tc), t3));
+}
+#endif
+
+void fm_table_eval_v(const fm_table *tbl, const double *x, double *y,
+                     size_t num)
+{
+    size_t i = 0;
+
+#if defined(__AVX__)
+    const __m256d lo = _mm256_set1_pd(tbl->lo);
+    const __m256d dinv = _mm256_set1_pd(tbl->dinv);
+    const __m256d dsq6 = _mm256_set1_pd(tbl->dsq6);
+    const __m256d tmax = _mm256_set1_pd((double) tbl->n);
+    const __m128i nmax = _mm_set1_epi32(tbl->n - 1);
+
+    for (; i + 4 <= num; i += 4)
+        _mm256_storeu_pd(y + i, fm_table_eval_avx(tbl->rec, lo, dinv, dsq6,
+                                                  tmax, nmax,
+                                                  _mm256_loadu_pd(x + i)));
+#endif
+    for (; i < num; ++i)
+        y[i] = fm_table_eval_inl(tbl->rec, tbl->lo, tbl->dinv, tbl->dsq6,
+                                 tbl->n, x[i]);
+}
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -33,6 +33,21 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 #include <time.h>
 #include <stdio.h>
+#include <fnmatch.h>
+#include <errno.h>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
 
 extern double exp10(double);
 extern float exp10f(float);
@@ -47,333 +62,1790 @@ static double wallclock(const double * __restrict ref)
     struct timespec t;
     double ret;
 
-    clock_gettime(CLOCK_REALTIME, &t);
+    clock_gettime(CLOCK_MONOTONIC, &t);
     ret = ((double) t.tv_sec)*1.0e6 + 1.0e-3*((double) t.tv_nsec);
 
     return ref ? (ret - *ref) : ret;
 }
 
-
-int main(int argc, char **argv)
+/* read the time stamp counter. returns 0 on CPUs without one. */
+static unsigned long long cyclecount(void)
 {
-    double *xval, *res0, *res1, *res2, *res3;
-    float  *xvalf, *res0f, *res1f, *res2f, *res3f;
-    double xscale, err, sumerr, start;
-    int num, rep, i, j;
-    unsigned int seed;
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
 
-    puts("\n============================="
-         "\nfastermath test and benchmark"
-         "\n=============================");
-    puts(config);
+/* optional hardware performance counters via perf_event_open(). each
+   counter is opened on its own and counts user space only, so that the
+   available ones are used when the kernel, the CPU or a container does
+   not provide all of them. the kernel multiplexes the counters, when
+   there are not enough, and the counts are scaled accordingly. */
+#define PERF_NUM 5
+static const char * const perfname[PERF_NUM] = {
+    "cyc", "ins", "l1dmiss", "brmiss", "uops"
+};
+static int perffd[PERF_NUM] = { -1, -1, -1, -1, -1 };
+static double perfval[PERF_NUM];
+
+#if defined(__linux__)
+static int perf_open(unsigned int type, unsigned long long config)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
 
-    if (argc < 3) {
-        printf("usage %s <num tests> <num reps> [<rng seed>]\n",argv[0]);
-        return -1;
-    }
+/* raw event for issued (Intel) or retired (AMD) micro-ops, 0 if unknown */
+static unsigned long long uops_event(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int a, b, c, d;
 
-    num = atoi(argv[1]);
-    rep = atoi(argv[2]);
-    if (argc < 4) {
-        seed = 1966;
-    } else {
-        seed = atoi(argv[3]);
+    if (__get_cpuid(0, &a, &b, &c, &d)) {
+        if (b == 0x756e6547) return 0x010e; /* GenuineIntel, UOPS_ISSUED.ANY */
+        if (b == 0x68747541) return 0x00c1; /* AuthenticAMD, retired uops */
     }
-    srand(seed);
-
-#define GRABMEM(var,type)                                          \
-    posix_memalign((void **)&var, _FM_ALIGN, num*sizeof(type)); \
-    memset(var, 0, num*sizeof(type))
-
-    GRABMEM(xval,double);
-    GRABMEM(res0,double);
-    GRABMEM(res1,double);
-    GRABMEM(res2,double);
-    GRABMEM(res3,double);
-
-    GRABMEM(xvalf,float);
-    GRABMEM(res0f,float);
-    GRABMEM(res1f,float);
-    GRABMEM(res2f,float);
-    GRABMEM(res3f,float);
-
-    puts("-------------------------\ntesting exponentiation functions");
-    err = sumerr = 0.0;
-    xscale = 1.0 / ((double) RAND_MAX);
-    start = wallclock(NULL);
-    /* random numbers distributed between -10.0 and 10.0 */ 
-    for (i=0; i < num; ++i) {
-        double r1,r2,rsum;
-        r1 = xscale * ((double) rand());
-        r2 = xscale * ((double) rand());
-        rsum = 0.5*(r1+r2);
-        xval[i] = 20.0 * rsum  - 10.0;
-        xvalf[i] = (float) xval[i];
-        err += xval[i];
-        sumerr += xval[i]*xval[i];
-    }
-    err /= (double) num;
-    sumerr /= (double) num;
-    printf("time/set for %d x-values : %8.4gus\n", num, wallclock(&start)/num);
-    printf("<x>: %.6g    <x**2> - <x>**2: %.15g\n", err, sumerr-(err*err));
+#endif
+    return 0;
+}
 
-    xscale = 1.0/(rep*num);
+/* open the counters. returns the number of available counters. */
+static int perf_init(void)
+{
+    int i, num = 0;
+#if defined(__linux__)
+    unsigned long long uops = uops_event();
+
+    perffd[0] = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    perffd[1] = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    perffd[2] = perf_open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    perffd[3] = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    if (uops) perffd[4] = perf_open(PERF_TYPE_RAW, uops);
+#endif
+    for (i=0; i < PERF_NUM; ++i)
+        if (perffd[i] >= 0) ++num;
+    return num;
+}
 
-#define DOUBLE_ERROR(ref,res)                           \
-    sumerr = 0.0;                                       \
-    for (i=0; i < num; ++i) {                           \
-        if (ref[i] != 0.0) sumerr += fabs(((double)res[i]- (double)ref[i])/((double) ref[i])); \
-    }                                                   \
-    printf("avgerr  %.6g\n", sumerr/((double) num))
+static void perf_start(void)
+{
+#if defined(__linux__)
+    int i;
 
-#define FLOAT_ERROR(ref,res)                            \
-    sumerrf = 0.0f;                                     \
-    for (i=0; i < num; ++i) {                           \
-        sumerrf += fabsf((res[i]-ref[i])/ref[i]);       \
-    }                                                   \
-    printf("avgerr  %.6g\n", sumerrf/((double) num))
+    for (i=0; i < PERF_NUM; ++i) {
+        if (perffd[i] < 0) continue;
+        ioctl(perffd[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(perffd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
 
-#define RUN_LOOP(x,result,func,type)            \
-    memset(result, 0, num*sizeof(type));        \
-    start = wallclock(NULL);                    \
-    for (j=0; j < rep; ++j) {                   \
-        for (i=0; i < num; ++i)                 \
-            result[i] += func(x[i]);            \
-    }                                           \
-    printf("time for% 20s(): %8.4fus  ",        \
-           #func, xscale*wallclock(&start))
+static void perf_stop(void)
+{
+    int i;
+#if defined(__linux__)
+    unsigned long long buf[3];
+
+    for (i=0; i < PERF_NUM; ++i)
+        if (perffd[i] >= 0) ioctl(perffd[i], PERF_EVENT_IOC_DISABLE, 0);
+    for (i=0; i < PERF_NUM; ++i) {
+        perfval[i] = -1.0;
+        if (perffd[i] < 0) continue;
+        if (read(perffd[i], buf, sizeof(buf)) != sizeof(buf)) continue;
+        if (buf[2] > 0)
+            perfval[i] = ((double) buf[0]) * ((double) buf[1])
+                / ((double) buf[2]);
+    }
+#else
+    for (i=0; i < PERF_NUM; ++i) perfval[i] = -1.0;
+#endif
+}
 
-    RUN_LOOP(xval,res0,exp2,double);
-    printf("numreps %d\n", rep);
+/* print the counts per element of the last measurement */
+static void perf_print(const char *name, double nelem)
+{
+    int i;
+
+    printf("counter % 20s():", name);
+    for (i=0; i < PERF_NUM; ++i) {
+        if (perfval[i] < 0.0)
+            printf(" %s      n/a", perfname[i]);
+        else
+            printf(" %s %8.3f", perfname[i], perfval[i]/nelem);
+    }
+    if ((perfval[0] > 0.0) && (perfval[1] >= 0.0))
+        printf(" ipc %5.2f", perfval[1]/perfval[0]);
+    putchar('\n');
+}
 
-    RUN_LOOP(xval,res1,__builtin_exp2,double);
-    DOUBLE_ERROR(res0,res1);
+static int useperf = 0;
 
-    RUN_LOOP(xval,res2,fm_exp2,double);
-    DOUBLE_ERROR(res0,res2);
+/* damped coulomb potential as an example for a function to tabulate */
+static double coul_erfc(double r)
+{
+    return erfc(0.3*r)/r;
+}
 
-    RUN_LOOP(xval,res0,exp,double);
-    printf("numreps %d\n", rep);
+/* input domains of the benchmarked functions */
+#define DOM_EXP  0
+#define DOM_LOG  1
+#define DOM_ERF  2
+#define DOM_NUM  3
+
+static const char * const domname[DOM_NUM] = {
+    "exponentiation", "logarithm", "error function and complement"
+};
+
+/* mask for the dependent call chains of the latency mode. each argument
+   is the next random argument c[i] xor the bits of the previous result
+   and this mask. it is zero, so the arguments keep their distribution
+   even where the results overflow, but since the compiler cannot know
+   that, the next call still has to wait for the previous one. */
+static volatile unsigned long long chainmask = 0;
+
+/* input distributions of the arguments, selected with --dist */
+#define DIST_TRIANGLE   0
+#define DIST_UNIFORM    1
+#define DIST_LOGUNIFORM 2
+#define DIST_GAUSS      3
+#define DIST_PAIRDIST   4
+#define DIST_BOUNDARY   5
+#define DIST_OVERFLOW   6
+
+static const char * const distname[] = {
+    "triangle", "uniform", "loguniform", "gauss", "pairdist",
+    "boundary", "overflow", NULL
+};
+
+/* range of the uniform distribution of each domain */
+static const double domlo[DOM_NUM] = { -10.0, 1.0/1024.0, -6.0 };
+static const double domhi[DOM_NUM] = {  10.0, 1024.0,     26.0 };
+
+/* uniform random number in ]0:1[ */
+static double urand(void)
+{
+    return (((double) rand()) + 0.5) / (((double) RAND_MAX) + 1.0);
+}
 
-    RUN_LOOP(xval,res1,__builtin_exp,double);
-    DOUBLE_ERROR(res0,res1);
+/* normal distributed random number with the Box-Muller method */
+static double grand(void)
+{
+    return sqrt(-2.0*log(urand())) * cos(2.0*M_PI*urand());
+}
 
-    RUN_LOOP(xval,res2,fm_exp,double);
-    DOUBLE_ERROR(res0,res2);
+/* move x by d units in the last place */
+static double ulpshift(double x, int d)
+{
+    union { double f; long long i; } v;
 
-    RUN_LOOP(xval,res3,fm_exp_alt,double);
-    DOUBLE_ERROR(res0,res3);
-    
-    RUN_LOOP(xval,res0,exp10,double);
-    printf("numreps %d\n", rep);
+    if (x == 0.0) return ldexp((double) d, -1074);
+    v.f = x;
+    v.i += (v.f < 0.0) ? -d : d;
+    return v.f;
+}
 
-    RUN_LOOP(xval,res1,__builtin_exp10,double);
-    DOUBLE_ERROR(res0,res1);
+static float ulpshiftf(float x, int d)
+{
+    union { float f; int i; } v;
 
-    RUN_LOOP(xval,res2,fm_exp10,double);
-    DOUBLE_ERROR(res0,res2);
+    if (x == 0.0f) return ldexpf((float) d, -149);
+    v.f = x;
+    v.i += (v.f < 0.0f) ? -d : d;
+    return v.f;
+}
 
-    RUN_LOOP(xval,res3,fm_exp10_alt,double);
-    DOUBLE_ERROR(res0,res3);
+/* a value on the boundary between two intervals of the argument
+   reduction, table or branches of the kernels of domain dom */
+static double boundary(int dom)
+{
+    union { double f; unsigned long long u; } v;
+    double b;
+
+    switch (dom) {
+      case DOM_EXP:
+          /* the rounding of x/log(2) or x/log10(2) to an integer
+             switches at the half-integers */
+          b = ((double) (rand() % 19 - 9)) + 0.5*(rand() & 1);
+          switch (rand() % 3) {
+            case 0: return b;
+            case 1: return b * 0.69314718055994530942;
+            default: return b * 0.30102999566398119521;
+          }
+      case DOM_LOG:
+          switch (rand() % 4) {
+            case 0:             /* cells of the 12-bit spline table */
+                b = 1.0 + ((double) (rand() % 4096)) / 4096.0;
+                break;
+            case 1:             /* cells of the compact and accurate log */
+                v.u = 0x3fe6000000000000ULL
+                    + (((unsigned long long) (rand() % 256)) << 44);
+                b = v.f;
+                break;
+            case 2:             /* reductions to [sqrt(0.5):sqrt(2)[ */
+                b = (rand() & 1) ? M_SQRT2 : M_SQRT1_2;
+                break;
+            default:
+                b = 1.0;
+          }
+          return ldexp(b, rand() % 20 - 10);
+      case DOM_ERF:
+      default:
+          /* intervals of y = 4/(4+|x|) in the erfcx() tables and the
+             cutoffs for large |x| */
+          b = 400.0 / ((double) (4 + rand() % 97)) - 4.0;
+          if (rand() & 1) return (b > 26.64) ? 26.64 : b;
+          return (b > 6.1) ? -6.1 : -b;
+    }
+}
 
+/* draw a random argument for domain dom from distribution dist for
+   double and single precision. the latter only differs for boundary
+   values and near overflow. */
+static void draw(int dom, int dist, double *x, float *xf)
+{
+    double r, lo, hi;
+    int d;
+
+    lo = domlo[dom];
+    hi = domhi[dom];
+    switch (dist) {
+      case DIST_UNIFORM:
+          *x = lo + (hi - lo)*urand();
+          break;
+      case DIST_LOGUNIFORM:
+          if (dom == DOM_LOG) {
+              *x = exp2(20.0*urand() - 10.0);
+          } else {
+              /* magnitudes from 1e-6 to the larger bound, random sign */
+              *x = 1.0e-6*exp(log(1.0e6*((hi > -lo) ? hi : -lo))*urand());
+              if (rand() & 1) *x = -*x;
+              if ((*x < lo) || (*x > hi)) *x = -*x;
+          }
+          break;
+      case DIST_GAUSS:
+          do {
+              r = grand();
+              *x = (dom == DOM_LOG) ? exp2(2.5*r) : 0.5*(lo+hi) + 0.125*(hi-lo)*r;
+          } while ((*x < lo) || (*x > hi));
+          break;
+      case DIST_PAIRDIST:
+          /* distances in [0.8:10] distributed like the pairs within the
+             cutoff of a liquid, i.e. proportional to r**2, used as in
+             exp(-r), log(r) and the Ewald sum erfc(0.35*r) */
+          r = cbrt(0.512 + (1000.0 - 0.512)*urand());
+          *x = (dom == DOM_EXP) ? -r : ((dom == DOM_LOG) ? r : 0.35*r);
+          break;
+      case DIST_BOUNDARY:
+          r = boundary(dom);
+          d = rand() % 5 - 2;
+          *x = ulpshift(r, d);
+          *xf = ulpshiftf((float) r, d);
+          return;
+      case DIST_OVERFLOW:
+          /* results close to overflow, or to underflow of the result
+             or the argument. the limits differ for single precision. */
+          r = urand();
+          d = rand() & 1;
+          if (dom == DOM_EXP) {
+              *x  = d ? 700.0 + 9.7*r : -745.0 + 37.0*r;
+              *xf = d ? 80.0f + 8.7f*r : -103.0f + 16.0f*r;
+          } else if (dom == DOM_LOG) {
+              *x  = exp2(d ? 1000.0 + 23.9*r : -1022.0 + 22.0*r);
+              *xf = exp2f(d ? 100.0f + 27.9f*r : -126.0f + 26.0f*r);
+          } else {
+              *x  = d ? 20.0 + 6.6*r : -6.1 + 1.1*r;
+              *xf = d ? 8.0f + 2.0f*r : -4.5f + 1.0f*r;
+          }
+          return;
+      case DIST_TRIANGLE:
+      default:
+          r = 0.5*(urand() + urand());
+          *x = (dom == DOM_LOG) ? exp2(20.0*r - 10.0) : lo + (hi - lo)*r;
+          break;
+    }
+    *xf = (float) *x;
+}
 
-    RUN_LOOP(xvalf,res0f,exp2f,float);
-    printf("numreps %d\n", rep);
+static int cmpdouble(const void *a, const void *b)
+{
+    const double da = *(const double *) a, db = *(const double *) b;
+    return (da > db) - (da < db);
+}
 
-    RUN_LOOP(xvalf,res1f,__builtin_exp2f,float);
-    DOUBLE_ERROR(res0f,res1f);
+static int cmpfloat(const void *a, const void *b)
+{
+    const float fa = *(const float *) a, fb = *(const float *) b;
+    return (fa > fb) - (fa < fb);
+}
 
-    RUN_LOOP(xvalf,res2f,fm_exp2f,float);
-    DOUBLE_ERROR(res0f,res2f);
+/* fill x and xf with num random arguments for domain dom. the
+   arguments are in random order or sorted in ascending order. */
+static void fill_domain(int dom, int dist, int sorted,
+                        double *x, float *xf, int num)
+{
+    double avg, var;
+    int i;
+
+    for (i=0; i < num; ++i)
+        draw(dom, dist, x+i, xf+i);
+    if (sorted) {
+        qsort(x, num, sizeof(double), cmpdouble);
+        qsort(xf, num, sizeof(float), cmpfloat);
+    }
 
-    RUN_LOOP(xvalf,res0f,expf,float);
-    printf("numreps %d\n", rep);
+    avg = var = 0.0;
+    for (i=0; i < num; ++i) {
+        avg += x[i];
+        var += x[i]*x[i];
+    }
+    avg /= (double) num;
+    var /= (double) num;
+    printf("%s distribution, %s order. <x>: %.6g    <x**2> - <x>**2: "
+           "%.15g\n", distname[dist], sorted ? "sorted" : "shuffled",
+           avg, var-(avg*avg));
+}
 
-    RUN_LOOP(xvalf,res1f,__builtin_expf,float);
-    DOUBLE_ERROR(res0f,res1f);
+/* list of benchmarked functions, expanded with the macros
+ *   FUNC(type,name,ref,dom)       scalar function called in a loop
+ *   EXPR(type,name,expr,ref,dom)  expression of x evaluated in a loop,
+ *                                 e.g. a builtin that may be inlined
+ *   BATCH(type,name,ref,dom)      batch function name(x,y,n)
+ * ref is the entry whose results are used as reference and must
+ * come first. adding a function only requires a new line here. */
+#define BENCH_LIST(FUNC,EXPR,BATCH)                                     \
+    FUNC(double,exp2,exp2,EXP)                                          \
+    EXPR(double,__builtin_exp2,__builtin_exp2(x),exp2,EXP)              \
+    FUNC(double,fm_exp2,exp2,EXP)                                       \
+    FUNC(double,fm_exp2_p24,exp2,EXP)                                   \
+    FUNC(double,fm_exp2_p40,exp2,EXP)                                   \
+    FUNC(double,fm_exp2_p52,exp2,EXP)                                   \
+    FUNC(double,fm_exp2_fma,exp2,EXP)                                   \
+    FUNC(double,fm_exp2_poly,exp2,EXP)                                  \
+    BATCH(double,fm_exp2_poly_v,exp2,EXP)                               \
+    BATCH(double,fm_exp2_v,exp2,EXP)                                    \
+    FUNC(double,exp,exp,EXP)                                            \
+    EXPR(double,__builtin_exp,__builtin_exp(x),exp,EXP)                 \
+    FUNC(double,fm_exp,exp,EXP)                                         \
+    FUNC(double,fm_exp_alt,exp,EXP)                                     \
+    FUNC(double,fm_exp_p24,exp,EXP)                                     \
+    FUNC(double,fm_exp_p40,exp,EXP)                                     \
+    FUNC(double,fm_exp_p52,exp,EXP)                                     \
+    FUNC(double,fm_exp_fma,exp,EXP)                                     \
+    FUNC(double,fm_exp_poly,exp,EXP)                                    \
+    BATCH(double,fm_exp_poly_v,exp,EXP)                                 \
+    BATCH(double,fm_exp_v,exp,EXP)                                      \
+    FUNC(double,exp10,exp10,EXP)                                        \
+    EXPR(double,__builtin_exp10,__builtin_exp10(x),exp10,EXP)           \
+    FUNC(double,fm_exp10,exp10,EXP)                                     \
+    FUNC(double,fm_exp10_alt,exp10,EXP)                                 \
+    FUNC(double,fm_exp10_fma,exp10,EXP)                                 \
+    FUNC(double,fm_exp10_poly,exp10,EXP)                                \
+    BATCH(double,fm_exp10_poly_v,exp10,EXP)                             \
+    BATCH(double,fm_exp10_v,exp10,EXP)                                  \
+    FUNC(float,exp2f,exp2f,EXP)                                         \
+    EXPR(float,__builtin_exp2f,__builtin_exp2f(x),exp2f,EXP)            \
+    FUNC(float,fm_exp2f,exp2f,EXP)                                      \
+    FUNC(float,fm_exp2f_p11,exp2f,EXP)                                  \
+    FUNC(float,fm_exp2f_p16,exp2f,EXP)                                  \
+    FUNC(float,fm_exp2f_p23,exp2f,EXP)                                  \
+    FUNC(float,fm_exp2f_lat,exp2f,EXP)                                  \
+    FUNC(float,expf,expf,EXP)                                           \
+    EXPR(float,__builtin_expf,__builtin_expf(x),expf,EXP)               \
+    FUNC(float,fm_expf,expf,EXP)                                        \
+    FUNC(float,fm_expf_alt,expf,EXP)                                    \
+    FUNC(float,fm_expf_p11,expf,EXP)                                    \
+    FUNC(float,fm_expf_p16,expf,EXP)                                    \
+    FUNC(float,fm_expf_p23,expf,EXP)                                    \
+    FUNC(float,fm_expf_lat,expf,EXP)                                    \
+    FUNC(float,fm_expf_alt_lat,expf,EXP)                                \
+    FUNC(float,exp10f,exp10f,EXP)                                       \
+    EXPR(float,__builtin_exp10f,__builtin_exp10f(x),exp10f,EXP)         \
+    FUNC(float,fm_exp10f,exp10f,EXP)                                    \
+    FUNC(float,fm_exp10f_alt,exp10f,EXP)                                \
+    FUNC(double,log2,log2,LOG)                                          \
+    EXPR(double,__builtin_log2,__builtin_log2(x),log2,LOG)              \
+    FUNC(double,fm_log2,log2,LOG)                                       \
+    FUNC(double,fm_log2_alt,log2,LOG)                                   \
+    FUNC(double,fm_log2_ieee,log2,LOG)                                  \
+    FUNC(double,fm_log2_fma,log2,LOG)                                   \
+    FUNC(double,fm_log2_poly,log2,LOG)                                  \
+    BATCH(double,fm_log2_poly_v,log2,LOG)                               \
+    BATCH(double,fm_log2_v,log2,LOG)                                    \
+    FUNC(double,fm_log2_p24,log2,LOG)                                   \
+    FUNC(double,fm_log2_p40,log2,LOG)                                   \
+    FUNC(double,fm_log2_p52,log2,LOG)                                   \
+    FUNC(double,fm_log2_accurate,log2,LOG)                              \
+    BATCH(double,fm_log2_accurate_v,log2,LOG)                           \
+    FUNC(double,log,log,LOG)                                            \
+    EXPR(double,__builtin_log,__builtin_log(x),log,LOG)                 \
+    FUNC(double,fm_log,log,LOG)                                         \
+    FUNC(double,fm_log_alt,log,LOG)                                     \
+    FUNC(double,fm_log_ieee,log,LOG)                                    \
+    FUNC(double,fm_log_fma,log,LOG)                                     \
+    FUNC(double,fm_log_poly,log,LOG)                                    \
+    BATCH(double,fm_log_poly_v,log,LOG)                                 \
+    BATCH(double,fm_log_v,log,LOG)                                      \
+    FUNC(double,fm_log_p24,log,LOG)                                     \
+    FUNC(double,fm_log_p40,log,LOG)                                     \
+    FUNC(double,fm_log_p52,log,LOG)                                     \
+    FUNC(double,fm_log_compact,log,LOG)                                 \
+    BATCH(double,fm_log_compact_v,log,LOG)                              \
+    FUNC(double,fm_log_accurate,log,LOG)                                \
+    BATCH(double,fm_log_accurate_v,log,LOG)                             \
+    FUNC(double,log10,log10,LOG)                                        \
+    EXPR(double,__builtin_log10,__builtin_log10(x),log10,LOG)           \
+    FUNC(double,fm_log10,log10,LOG)                                     \
+    FUNC(double,fm_log10_alt,log10,LOG)                                 \
+    FUNC(double,fm_log10_ieee,log10,LOG)                                \
+    FUNC(double,fm_log10_fma,log10,LOG)                                 \
+    FUNC(double,fm_log10_poly,log10,LOG)                                \
+    BATCH(double,fm_log10_poly_v,log10,LOG)                             \
+    BATCH(double,fm_log10_v,log10,LOG)                                  \
+    FUNC(double,fm_log10_accurate,log10,LOG)                            \
+    BATCH(double,fm_log10_accurate_v,log10,LOG)                         \
+    FUNC(float,log2f,log2f,LOG)                                         \
+    EXPR(float,__builtin_log2f,__builtin_log2f(x),log2f,LOG)            \
+    FUNC(float,fm_log2f,log2f,LOG)                                      \
+    FUNC(float,fm_log2f_alt,log2f,LOG)                                  \
+    FUNC(float,fm_log2f_ieee,log2f,LOG)                                 \
+    FUNC(float,fm_log2f_p11,log2f,LOG)                                  \
+    FUNC(float,fm_log2f_p16,log2f,LOG)                                  \
+    FUNC(float,fm_log2f_p23,log2f,LOG)                                  \
+    FUNC(float,fm_log2f_alt_lat,log2f,LOG)                              \
+    FUNC(float,logf,logf,LOG)                                           \
+    EXPR(float,__builtin_logf,__builtin_logf(x),logf,LOG)               \
+    FUNC(float,fm_logf,logf,LOG)                                        \
+    FUNC(float,fm_logf_alt,logf,LOG)                                    \
+    FUNC(float,fm_logf_ieee,logf,LOG)                                   \
+    FUNC(float,fm_logf_p11,logf,LOG)                                    \
+    FUNC(float,fm_logf_p16,logf,LOG)                                    \
+    FUNC(float,fm_logf_p23,logf,LOG)                                    \
+    FUNC(float,log10f,log10f,LOG)                                       \
+    EXPR(float,__builtin_log10f,__builtin_log10f(x),log10f,LOG)         \
+    FUNC(float,fm_log10f,log10f,LOG)                                    \
+    FUNC(float,fm_log10f_alt,log10f,LOG)                                \
+    FUNC(float,fm_log10f_ieee,log10f,LOG)                               \
+    FUNC(double,erf,erf,ERF)                                            \
+    EXPR(double,__builtin_erf,__builtin_erf(x),erf,ERF)                 \
+    EXPR(double,one_minus_erfc,1.0 - erfc(x),erf,ERF)                   \
+    FUNC(double,erfc,erfc,ERF)                                          \
+    EXPR(double,__builtin_erfc,__builtin_erfc(x),erfc,ERF)              \
+    EXPR(double,one_minus_erf,1.0 - erf(x),erfc,ERF)                    \
+    FUNC(double,fm_erfc,erfc,ERF)                                       \
+    FUNC(double,fm_erfc_lat,erfc,ERF)                                   \
+    FUNC(double,fm_erfc_fma,erfc,ERF)                                   \
+    FUNC(float,erff,erff,ERF)                                           \
+    EXPR(float,__builtin_erff,__builtin_erff(x),erff,ERF)               \
+    EXPR(float,one_minus_erfcf,1.0f - erfcf(x),erff,ERF)                \
+    FUNC(float,erfcf,erfcf,ERF)                                         \
+    EXPR(float,__builtin_erfcf,__builtin_erfcf(x),erfcf,ERF)            \
+    EXPR(float,one_minus_erff,1.0f - erff(x),erfcf,ERF)                 \
+    FUNC(float,fm_erfcf,erfcf,ERF)
+
+/* every entry is run through a function with the same signature.
+   scalar and inline entries also have a dependent call chain. */
+typedef void (*bench_fn)(const void *x, void *y, int n);
+typedef double (*chain_fn)(const void *c, int n, unsigned long long m);
+
+#define BENCH_FUNC_DEF(type,name,ref,dom)                       \
+    static void bench_ ## name(const void *xv, void *yv, int n) \
+    {                                                           \
+        const type *x = (const type *) xv;                      \
+        type *y = (type *) yv;                                  \
+        int i;                                                  \
+        for (i=0; i < n; ++i)                                   \
+            y[i] = name(x[i]);                                  \
+    }                                                           \
+    static double chain_ ## name(const void *cv, int n,        \
+                                 unsigned long long m)          \
+    {                                                           \
+        const type *c = (const type *) cv;                      \
+        union { type f; unsigned long long u; } x, y;           \
+        int i;                                                  \
+        x.u = y.u = 0;                                          \
+        x.f = c[0];                                             \
+        for (i=0; i < n; ++i) {                                 \
+            y.f = name(x.f);                                    \
+            x.f = c[i];                                         \
+            x.u ^= y.u & m;                                     \
+        }                                                       \
+        return x.f;                                             \
+    }
 
-    RUN_LOOP(xvalf,res2f,fm_expf,float);
-    DOUBLE_ERROR(res0f,res2f);
+#define BENCH_EXPR_DEF(type,name,expr,ref,dom)                  \
+    static void bench_ ## name(const void *xv, void *yv, int n) \
+    {                                                           \
+        const type *xp = (const type *) xv;                     \
+        type *y = (type *) yv;                                  \
+        int i;                                                  \
+        for (i=0; i < n; ++i) {                                 \
+            const type x = xp[i];                               \
+            y[i] = expr;                                        \
+        }                                                       \
+    }                                                           \
+    static double chain_ ## name(const void *cv, int n,        \
+                                 unsigned long long m)          \
+    {                                                           \
+        const type *c = (const type *) cv;                      \
+        union { type f; unsigned long long u; } xc, y;          \
+        int i;                                                  \
+        xc.u = y.u = 0;                                         \
+        xc.f = c[0];                                            \
+        for (i=0; i < n; ++i) {                                 \
+            const type x = xc.f;                                \
+            y.f = expr;                                         \
+            xc.f = c[i];                                        \
+            xc.u ^= y.u & m;                                    \
+        }                                                       \
+        return xc.f;                                            \
+    }
 
-    RUN_LOOP(xvalf,res3f,fm_expf_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
-    
-    RUN_LOOP(xvalf,res0f,exp10f,float);
-    printf("numreps %d\n", rep);
+#define BENCH_BATCH_DEF(type,name,ref,dom)                      \
+    static void bench_ ## name(const void *xv, void *yv, int n) \
+    {                                                           \
+        name((const type *) xv, (type *) yv, n);                \
+    }
 
-    RUN_LOOP(xvalf,res1f,__builtin_exp10f,float);
-    DOUBLE_ERROR(res0f,res1f);
+BENCH_LIST(BENCH_FUNC_DEF,BENCH_EXPR_DEF,BENCH_BATCH_DEF)
+
+#define BENCH_SCALAR 0
+#define BENCH_INLINE 1
+#define BENCH_BATCH  2
+
+static const char * const kindname[] = { "scalar", "inline", "batch" };
+
+typedef struct {
+    const char *name;           /* name of the function */
+    bench_fn run;               /* loop over the function */
+    bench_fn ref;               /* loop over the reference function */
+    chain_fn chain;             /* dependent call chain or NULL */
+    const char *refname;        /* name of the reference function */
+    int size;                   /* size of the element type */
+    int kind;                   /* scalar, inline or batch */
+    int dom;                    /* input domain */
+} bench_t;
+
+#define BENCH_FUNC_ENT(type,name,ref,dom)                               \
+    { #name, bench_ ## name, bench_ ## ref, chain_ ## name, #ref,       \
+      sizeof(type), BENCH_SCALAR, DOM_ ## dom },
+#define BENCH_EXPR_ENT(type,name,expr,ref,dom)                          \
+    { #name, bench_ ## name, bench_ ## ref, chain_ ## name, #ref,       \
+      sizeof(type), BENCH_INLINE, DOM_ ## dom },
+#define BENCH_BATCH_ENT(type,name,ref,dom)                              \
+    { #name, bench_ ## name, bench_ ## ref, NULL, #ref,                 \
+      sizeof(type), BENCH_BATCH, DOM_ ## dom },
+
+static const bench_t bench[] = {
+    BENCH_LIST(BENCH_FUNC_ENT,BENCH_EXPR_ENT,BENCH_BATCH_ENT)
+};
+static const int nbench = sizeof(bench)/sizeof(bench[0]);
+
+/* glob patterns from --filter. an empty list selects everything. */
+#define MAX_FILTER 32
+static const char *filter[MAX_FILTER];
+static int nfilter = 0;
+
+static int selected(const char *name)
+{
+    int i;
 
-    RUN_LOOP(xvalf,res2f,fm_exp10f,float);
-    DOUBLE_ERROR(res0f,res2f);
+    if (nfilter == 0) return 1;
+    for (i=0; i < nfilter; ++i)
+        if (fnmatch(filter[i], name, 0) == 0) return 1;
+    return 0;
+}
 
-    RUN_LOOP(xvalf,res3f,fm_exp10f_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
+/* classify x as finite (0), +inf (1), -inf (2) or NaN (3). this
+   checks the bits, since the tester is compiled with -ffast-math. */
+static int fpclass(double x)
+{
+    union { double f; unsigned long long u; } v;
 
+    v.f = x;
+    if (((v.u >> 52) & 0x7ff) != 0x7ff) return 0;
+    if (v.u << 12) return 3;
+    return (v.u >> 63) ? 2 : 1;
+}
 
-    puts("-------------------------\ntesting logarithm functions");
-    err = sumerr = 0.0;
-    xscale = 1.0 / ((double) RAND_MAX);
-    start = wallclock(NULL);
-    /* random numbers distributed between 2**-10.0 and 2**10.0 */ 
-    for (i=0; i < num; ++i) {
-        double r1,r2,rsum;
-        r1 = xscale * ((double) rand());
-        r2 = xscale * ((double) rand());
-        rsum = 0.5*(r1+r2);
-        xval[i] = exp2(20.0 * rsum  - 10.0);
-        xvalf[i] = (float) xval[i];
-        err += xval[i];
-        sumerr += xval[i]*xval[i];
-    }
-    err /= (double) num;
-    sumerr /= (double) num;
-    printf("time/set for %d x-values : %8.4gus\n", num, wallclock(&start)/num);
-    xscale = 1.0/(rep*num);
+/* machine readable results from --output. the header with the build
+   configuration and the CPU model is written before the first test and
+   each record as soon as it is measured, so that an aborted run still
+   leaves the completed measurements. the hand written sections are
+   only reported as text. */
+#define FMT_CSV  1
+#define FMT_JSON 2
+static FILE *outfp = NULL;
+static int outfmt = 0;
+static int nout = 0;
+static int outdist = 0;
+static int outsorted = 0;
+
+/* copy the value of the line "key= value" of the build configuration */
+static void config_value(const char *key, char *buf, int len)
+{
+    const char *p, *e;
+    const size_t klen = strlen(key);
+    int i;
+
+    buf[0] = '\0';
+    for (p = config; *p; p = e + (*e != '\0')) {
+        e = strchr(p, '\n');
+        if (!e) e = p + strlen(p);
+        if ((strncmp(p, key, klen) != 0) || (p[klen] != '=')) continue;
+        for (p += klen + 1; (p < e) && (*p == ' '); ++p);
+        for (i=0; (p < e) && (i < len-1); ++i) buf[i] = *p++;
+        buf[i] = '\0';
+        return;
+    }
+}
 
-    RUN_LOOP(xval,res0,log2,double);
-    printf("numreps %d\n", rep);
+/* the CPU model from the cpuid brand string or /proc/cpuinfo */
+static void cpu_model(char *buf, int len)
+{
+    FILE *fp;
+    char line[256], *p;
+    int i;
+
+    strncpy(buf, "unknown", len);
+#if defined(__x86_64__) || defined(__i386__)
+    {
+        unsigned int r[13], a, b, c, d;
+
+        if (__get_cpuid(0x80000000, &a, &b, &c, &d) && (a >= 0x80000004)) {
+            for (i=0; i < 3; ++i)
+                __get_cpuid(0x80000002+i, r+4*i, r+4*i+1, r+4*i+2, r+4*i+3);
+            r[12] = 0;
+            strncpy(buf, (const char *) r, len);
+        }
+    }
+#endif
+    fp = fopen("/proc/cpuinfo", "r");
+    if (fp) {
+        while (fgets(line, sizeof(line), fp)) {
+            if (strncmp(line, "model name", 10) != 0) continue;
+            p = strchr(line, ':');
+            if (p) strncpy(buf, p+1, len);
+            break;
+        }
+        fclose(fp);
+    }
+    buf[len-1] = '\0';
+
+    /* remove the padding of the brand string */
+    for (p = buf; *p == ' '; ++p);
+    memmove(buf, p, strlen(p)+1);
+    for (i = strlen(buf); (i > 0) && ((buf[i-1] == ' ')
+                                      || (buf[i-1] == '\n')); --i)
+        buf[i-1] = '\0';
+}
 
-    RUN_LOOP(xval,res1,__builtin_log2,double);
-    DOUBLE_ERROR(res0,res1);
+/* write s as a JSON string */
+static void json_string(FILE *fp, const char *s)
+{
+    fputc('"', fp);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') fprintf(fp, "\\%c", *s);
+        else if (*s == '\n') fputs("\\n", fp);
+        else if (*s == '\t') fputs("\\t", fp);
+        else if ((unsigned char) *s < 0x20) fprintf(fp, "\\u%04x", *s);
+        else fputc(*s, fp);
+    }
+    fputc('"', fp);
+}
 
-    RUN_LOOP(xval,res2,fm_log2,double);
-    DOUBLE_ERROR(res0,res2);
+static const char * const outcols[] = {
+    "arch", "name", "kind", "type", "ref", "domain", "dist", "order",
+    "mode", "n", "reps", "ns", "ns_sd", "ns_min", "cyc", "rate",
+    "avgerr", "maxerr", NULL
+};
 
-    RUN_LOOP(xval,res3,fm_log2_alt,double);
-    DOUBLE_ERROR(res0,res3);
+static void out_header(int num, int rep, unsigned int seed,
+                       int dist, int sorted)
+{
+    char arch[64], cpu[128];
+    const char *p;
+    int i;
+
+    outdist = dist;
+    outsorted = sorted;
+    config_value("ARCH", arch, sizeof(arch));
+    cpu_model(cpu, sizeof(cpu));
+    if (outfmt == FMT_CSV) {
+        /* the configuration and the CPU go into comment lines */
+        fprintf(outfp, "# fastermath benchmark results\n# cpu: %s\n", cpu);
+        for (p = config; *p; ++p) {
+            if ((p == config) || (p[-1] == '\n')) fputs("# ", outfp);
+            fputc(*p, outfp);
+        }
+        fprintf(outfp, "# n: %d reps: %d seed: %u dist: %s order: %s\n",
+                num, rep, seed, distname[dist],
+                sorted ? "sorted" : "shuffled");
+        for (i=0; outcols[i]; ++i)
+            fprintf(outfp, "%s%s", i ? "," : "", outcols[i]);
+        for (i=0; i < PERF_NUM; ++i)
+            fprintf(outfp, ",perf_%s", perfname[i]);
+        fputc('\n', outfp);
+    } else {
+        fputs("{\n  \"arch\": ", outfp);
+        json_string(outfp, arch);
+        fputs(",\n  \"cpu\": ", outfp);
+        json_string(outfp, cpu);
+        fputs(",\n  \"config\": ", outfp);
+        json_string(outfp, config);
+        fprintf(outfp, ",\n  \"n\": %d,\n  \"reps\": %d,\n  \"seed\": %u,"
+                "\n  \"dist\": \"%s\",\n  \"order\": \"%s\",\n"
+                "  \"results\": [", num, rep, seed, distname[dist],
+                sorted ? "sorted" : "shuffled");
+    }
+    fflush(outfp);
+}
 
-    RUN_LOOP(xval,res0,log,double);
-    printf("numreps %d\n", rep);
+/* write one record. the times are the sum, the sum of squares and the
+   minimum of the time of the rep repetitions in us. negative errors
+   are not available and written as empty fields or null. */
+static void out_result(const bench_t *b, const char *mode, int num,
+                       int rep, double sum, double sumsq, double tmin,
+                       double cyc, double avgerr, double maxerr)
+{
+    char arch[64];
+    double ns, sd, val[PERF_NUM+7];
+    int i;
+
+    if (!outfp) return;
+    config_value("ARCH", arch, sizeof(arch));
+
+    /* time per element in ns with its spread between repetitions */
+    ns = 1000.0*sum/(((double) num)*((double) rep));
+    sd = 0.0;
+    if (rep > 1) {
+        sd = (sumsq - sum*sum/((double) rep))/((double) (rep - 1));
+        sd = (sd > 0.0) ? 1000.0*sqrt(sd)/((double) num) : 0.0;
+    }
+    val[0] = ns;
+    val[1] = sd;
+    val[2] = 1000.0*tmin/((double) num);
+    val[3] = cyc/(((double) num)*((double) rep));
+    val[4] = 1.0e9/ns;
+    val[5] = avgerr;
+    val[6] = maxerr;
+    for (i=0; i < PERF_NUM; ++i)
+        val[7+i] = (useperf && (perfval[i] >= 0.0))
+            ? perfval[i]/(((double) num)*((double) rep)) : -1.0;
+
+    if (outfmt == FMT_CSV) {
+        fprintf(outfp, "%s,%s,%s,%s,%s,%s,%s,%s,%s,%d,%d", arch, b->name,
+                kindname[b->kind],
+                (b->size == sizeof(double)) ? "double" : "float",
+                b->refname, domname[b->dom], distname[outdist],
+                outsorted ? "sorted" : "shuffled", mode, num, rep);
+        for (i=0; i < PERF_NUM+7; ++i) {
+            if (val[i] < 0.0) fputc(',', outfp);
+            else fprintf(outfp, ",%.6g", val[i]);
+        }
+        fputc('\n', outfp);
+    } else {
+        fprintf(outfp, "%s\n    {\"name\": \"%s\", \"kind\": \"%s\", "
+                "\"type\": \"%s\", \"ref\": \"%s\", \"domain\": \"%s\", "
+                "\"mode\": \"%s\"", nout ? "," : "", b->name,
+                kindname[b->kind],
+                (b->size == sizeof(double)) ? "double" : "float",
+                b->refname, domname[b->dom], mode);
+        for (i=0; i < PERF_NUM+7; ++i) {
+            if (i < 7) fprintf(outfp, ", \"%s\": ", outcols[11+i]);
+            else fprintf(outfp, ", \"perf_%s\": ", perfname[i-7]);
+            if (val[i] < 0.0) fputs("null", outfp);
+            else fprintf(outfp, "%.6g", val[i]);
+        }
+        fputc('}', outfp);
+    }
+    ++nout;
+    fflush(outfp);
+}
 
-    RUN_LOOP(xval,res1,__builtin_log,double);
-    DOUBLE_ERROR(res0,res1);
+static void out_footer(void)
+{
+    if (outfmt == FMT_JSON) fputs("\n  ]\n}\n", outfp);
+    fclose(outfp);
+    outfp = NULL;
+}
 
-    RUN_LOOP(xval,res2,fm_log,double);
-    DOUBLE_ERROR(res0,res2);
+/* time rep calls of the loop of entry b over num elements of x
+   and compare the results to those of the reference in yref. */
+static void run_bench(const bench_t *b, const void *x, void *y,
+                      const void *yref, int num, int rep)
+{
+    double start, t, tj, tsq, tmin, nelem, r, v, err, sumerr, maxerr;
+    unsigned long long c0, c1;
+    int i, j;
+
+    b->run(x, y, num);
+    if (useperf) perf_start();
+    t = tsq = 0.0;
+    tmin = 1.0e300;
+    c0 = cyclecount();
+    for (j=0; j < rep; ++j) {
+        start = wallclock(NULL);
+        b->run(x, y, num);
+        tj = wallclock(&start);
+        t += tj;
+        tsq += tj*tj;
+        if (tj < tmin) tmin = tj;
+    }
+    c1 = cyclecount();
+    if (useperf) perf_stop();
+    nelem = ((double) num) * ((double) rep);
 
-    RUN_LOOP(xval,res3,fm_log_alt,double);
-    DOUBLE_ERROR(res0,res3);
+    sumerr = maxerr = 0.0;
+    for (i=0; i < num; ++i) {
+        if (b->size == sizeof(double)) {
+            r = ((const double *) yref)[i];
+            v = ((const double *) y)[i];
+        } else {
+            r = ((const float *) yref)[i];
+            v = ((const float *) y)[i];
+        }
+        if (fpclass(r) || fpclass(v)) {
+            /* overflow and NaN must match the reference */
+            err = (fpclass(r) == fpclass(v)) ? 0.0 : 1.0;
+        } else if (r != 0.0) {
+            err = fabs((v - r)/r);
+        } else continue;
+        sumerr += err;
+        if (err > maxerr) maxerr = err;
+    }
+    printf("time for% 20s(): %8.4fns %8.2fcyc %10.4g/s  "
+           "avgerr  %.6g  maxerr  %.6g\n", b->name, 1000.0*t/nelem,
+           ((double) (c1 - c0))/nelem, 1.0e6*nelem/t,
+           sumerr/((double) num), maxerr);
+    if (useperf) perf_print(b->name, nelem);
+    out_result(b, "throughput", num, rep, t, tsq, tmin,
+               (double) (c1 - c0), sumerr/((double) num), maxerr);
+}
 
-    RUN_LOOP(xval,res0,log10,double);
-    printf("numreps %d\n", rep);
+/* time rep dependent call chains of entry b over the num arguments
+   in c. the result is stored in *sink, so that it is not optimized out. */
+static void run_chain(const bench_t *b, const void *c, double *sink,
+                      int num, int rep)
+{
+    double start, t, tj, tsq, tmin, nelem, sum;
+    unsigned long long c0, c1;
+    int j;
+
+    sum = b->chain(c, num, chainmask);
+    if (useperf) perf_start();
+    t = tsq = 0.0;
+    tmin = 1.0e300;
+    c0 = cyclecount();
+    for (j=0; j < rep; ++j) {
+        start = wallclock(NULL);
+        sum += b->chain(c, num, chainmask);
+        tj = wallclock(&start);
+        t += tj;
+        tsq += tj*tj;
+        if (tj < tmin) tmin = tj;
+    }
+    c1 = cyclecount();
+    if (useperf) perf_stop();
+    nelem = ((double) num) * ((double) rep);
+    *sink += sum;
+
+    printf("latency % 20s(): %8.4fns %8.2fcyc\n", b->name,
+           1000.0*t/nelem, ((double) (c1 - c0))/nelem);
+    if (useperf) perf_print(b->name, nelem);
+    out_result(b, "latency", num, rep, t, tsq, tmin,
+               (double) (c1 - c0), -1.0, -1.0);
+}
 
-    RUN_LOOP(xval,res1,__builtin_log10,double);
-    DOUBLE_ERROR(res0,res1);
+/* match the command line option name as "name value" or "name=value".
+   returns the value or NULL. */
+static const char *optval(int argc, char **argv, int *idx, const char *name)
+{
+    const char *arg = argv[*idx];
+    const size_t len = strlen(name);
 
-    RUN_LOOP(xval,res2,fm_log10,double);
-    DOUBLE_ERROR(res0,res2);
+    if (strncmp(arg, name, len) != 0) return NULL;
+    if (arg[len] == '=') return arg + len + 1;
+    if ((arg[len] == '\0') && (*idx + 1 < argc)) return argv[++(*idx)];
+    return NULL;
+}
 
-    RUN_LOOP(xval,res3,fm_log10_alt,double);
-    DOUBLE_ERROR(res0,res3);
+static void usage(const char *prog)
+{
+    printf("usage %s [<options>] [<num tests> <num reps> [<rng seed>]]\n"
+           "options:\n"
+           "  --filter <glob>  run only matching functions or sections.\n"
+           "                   may be repeated or a comma separated list\n"
+           "  --n <num>        number of elements (default 100000)\n"
+           "  --reps <num>     number of repetitions (default 10)\n"
+           "  --seed <num>     seed of the random number generator\n"
+           "  --mode <mode>    throughput, latency or both (default)\n"
+           "  --perf           read hardware performance counters\n"
+           "  --dist <name>    distribution of the arguments: triangle\n"
+           "                   (default), uniform, loguniform, gauss,\n"
+           "                   pairdist, boundary or overflow\n"
+           "  --order <order>  shuffled (default) or sorted arguments\n"
+           "  --output <file>  also write the results to file\n"
+           "  --format <fmt>   json or csv format of the output file\n"
+           "                   (default: csv for *.csv, else json)\n"
+           "  --list           list functions and sections and exit\n",
+           prog);
+}
 
-    RUN_LOOP(xvalf,res0f,log2f,float);
-    printf("numreps %d\n", rep);
+/* names of the hand written test sections for --filter and --list */
+static const char * const sections[] = {
+    "special", "half", "bandwidth", "omp", "strided", "masked", "fused",
+    "sum_log", "log_int", "table", "cache", NULL
+};
 
-    RUN_LOOP(xvalf,res1f,__builtin_log2f,float);
-    DOUBLE_ERROR(res0f,res1f);
+int main(int argc, char **argv)
+{
+    double *xval, *res0, *res1, *res2, *res3;
+    float  *xvalf, *res0f, *res1f, *res2f, *res3f;
+    double xscale, sumerr, start;
+    int num, rep, i, j, k, d, npos, list, mode, dist, sorted;
+    unsigned int seed;
+    const char *val, *outname;
+    char *pat;
+
+    num = 100000;
+    rep = 10;
+    seed = 1966;
+    npos = list = 0;
+    mode = 3;
+    dist = DIST_TRIANGLE;
+    sorted = 0;
+    outname = NULL;
+    for (i=1; i < argc; ++i) {
+        if ((val = optval(argc, argv, &i, "--filter"))) {
+            pat = strdup(val);
+            for (pat = strtok(pat, ","); pat && (nfilter < MAX_FILTER);
+                 pat = strtok(NULL, ","))
+                filter[nfilter++] = pat;
+        } else if ((val = optval(argc, argv, &i, "--n"))) {
+            num = atoi(val);
+        } else if ((val = optval(argc, argv, &i, "--reps"))) {
+            rep = atoi(val);
+        } else if ((val = optval(argc, argv, &i, "--seed"))) {
+            seed = atoi(val);
+        } else if ((val = optval(argc, argv, &i, "--mode"))) {
+            if (strcmp(val, "throughput") == 0) mode = 1;
+            else if (strcmp(val, "latency") == 0) mode = 2;
+            else if (strcmp(val, "both") == 0) mode = 3;
+            else mode = 0;
+        } else if ((val = optval(argc, argv, &i, "--dist"))) {
+            for (dist=0; distname[dist]; ++dist)
+                if (strcmp(val, distname[dist]) == 0) break;
+            if (!distname[dist]) dist = -1;
+        } else if ((val = optval(argc, argv, &i, "--order"))) {
+            if (strcmp(val, "sorted") == 0) sorted = 1;
+            else if (strcmp(val, "shuffled") == 0) sorted = 0;
+            else sorted = -1;
+        } else if ((val = optval(argc, argv, &i, "--output"))) {
+            outname = val;
+        } else if ((val = optval(argc, argv, &i, "--format"))) {
+            if (strcmp(val, "json") == 0) outfmt = FMT_JSON;
+            else if (strcmp(val, "csv") == 0) outfmt = FMT_CSV;
+            else outfmt = -1;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list = 1;
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            useperf = 1;
+        } else if (argv[i][0] != '-') {
+            if (npos == 0) num = atoi(argv[i]);
+            else if (npos == 1) rep = atoi(argv[i]);
+            else if (npos == 2) seed = atoi(argv[i]);
+            ++npos;
+        } else {
+            usage(argv[0]);
+            return -1;
+        }
+    }
 
-    RUN_LOOP(xvalf,res2f,fm_log2f,float);
-    DOUBLE_ERROR(res0f,res2f);
+    if (list) {
+        for (k=0; k < nbench; ++k)
+            printf("% 20s  %-6s  %-6s  ref % 10s  %s\n", bench[k].name,
+                   kindname[bench[k].kind],
+                   (bench[k].size == sizeof(double)) ? "double" : "float",
+                   bench[k].refname, domname[bench[k].dom]);
+        for (k=0; sections[k]; ++k)
+            printf("% 20s  section\n", sections[k]);
+        return 0;
+    }
 
-    RUN_LOOP(xvalf,res3f,fm_log2f_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
+    if ((num < 1) || (rep < 1) || (mode == 0)
+        || (dist < 0) || (sorted < 0) || (outfmt < 0)
+        || (outfmt && !outname)) {
+        usage(argv[0]);
+        return -1;
+    }
 
-    RUN_LOOP(xvalf,res0f,logf,float);
-    printf("numreps %d\n", rep);
+    if (outname) {
+        k = strlen(outname);
+        if (outfmt == 0)
+            outfmt = ((k > 4) && (strcmp(outname + k - 4, ".csv") == 0))
+                ? FMT_CSV : FMT_JSON;
+        outfp = fopen(outname, "w");
+        if (!outfp) {
+            printf("cannot open output file %s: %s\n", outname,
+                   strerror(errno));
+            return -1;
+        }
+    }
 
-    RUN_LOOP(xvalf,res1f,__builtin_logf,float);
-    DOUBLE_ERROR(res0f,res1f);
+    puts("\n============================="
+         "\nfastermath test and benchmark"
+         "\n=============================");
+    puts(config);
+    srand(seed);
 
-    RUN_LOOP(xvalf,res2f,fm_logf,float);
-    DOUBLE_ERROR(res0f,res2f);
+    if (useperf) {
+        errno = 0;
+        k = perf_init();
+        if (k == 0) {
+            printf("performance counters not available: %s\n",
+                   errno ? strerror(errno) : "unsupported platform");
+            useperf = 0;
+        } else {
+            printf("reading %d of %d performance counters per element:",
+                   k, PERF_NUM);
+            for (i=0; i < PERF_NUM; ++i)
+                if (perffd[i] >= 0) printf(" %s", perfname[i]);
+            putchar('\n');
+        }
+    }
+    if (outfp) out_header(num, rep, seed, dist, sorted);
 
-    RUN_LOOP(xvalf,res3f,fm_logf_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
+#define GRABMEM(var,type)                                          \
+    posix_memalign((void **)&var, _FM_ALIGN, num*sizeof(type)); \
+    memset(var, 0, num*sizeof(type))
 
-    RUN_LOOP(xvalf,res0f,log10f,float);
-    printf("numreps %d\n", rep);
+    GRABMEM(xval,double);
+    GRABMEM(res0,double);
+    GRABMEM(res1,double);
+    GRABMEM(res2,double);
+    GRABMEM(res3,double);
 
-    RUN_LOOP(xvalf,res1f,__builtin_log10f,float);
-    DOUBLE_ERROR(res0f,res1f);
+    GRABMEM(xvalf,float);
+    GRABMEM(res0f,float);
+    GRABMEM(res1f,float);
+    GRABMEM(res2f,float);
+    GRABMEM(res3f,float);
 
-    RUN_LOOP(xvalf,res2f,fm_log10f,float);
-    DOUBLE_ERROR(res0f,res2f);
+    printf("%d elements, %d repetitions. time, TSC cycles and "
+           "throughput per element\n", num, rep);
+    if (mode & 2)
+        puts("latency: time and TSC cycles per call in a chain "
+             "x = c[i] ^ (f(x) & 0), including the xor");
+    for (d=0; d < DOM_NUM; ++d) {
+        bench_fn ref = NULL;
+
+        for (k=0; k < nbench; ++k)
+            if ((bench[k].dom == d) && selected(bench[k].name)) break;
+        if (k == nbench) continue;
+
+        printf("-------------------------\ntesting %s functions\n",
+               domname[d]);
+        fill_domain(d, dist, sorted, xval, xvalf, num);
+        for (k=0; k < nbench; ++k) {
+            const bench_t *b = bench + k;
+
+            if ((b->dom != d) || !selected(b->name)) continue;
+            if (mode & 1) {
+                if (b->size == sizeof(double)) {
+                    if (b->ref != ref) b->ref(xval, res0, num);
+                    run_bench(b, xval, res1, res0, num, rep);
+                } else {
+                    if (b->ref != ref) b->ref(xvalf, res0f, num);
+                    run_bench(b, xvalf, res1f, res0f, num, rep);
+                }
+                ref = b->ref;
+            }
+            if ((mode & 2) && b->chain)
+                run_chain(b, (b->size == sizeof(double))
+                          ? (const void *) xval : (const void *) xvalf,
+                          res2, num, rep);
+        }
+    }
 
-    RUN_LOOP(xvalf,res3f,fm_log10f_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
+#define DOUBLE_ERROR(ref,res)                           \
+    sumerr = 0.0;                                       \
+    for (i=0; i < num; ++i) {                           \
+        if (ref[i] != 0.0) sumerr += fabs(((double)res[i]- (double)ref[i])/((double) ref[i])); \
+    }                                                   \
+    printf("avgerr  %.6g\n", sumerr/((double) num))
 
-    puts("-------------------------\ntesting error function and complement");
-    err = sumerr = 0.0;
-    xscale = 16.0 / ((double) RAND_MAX);
-    start = wallclock(NULL);
-    /* random numbers distributed between -6.0 and 26.0 */ 
-    for (i=0; i < num; ++i) {
-        double r1,r2,rsum;
-        r1 = xscale * ((double) rand());
-        r2 = xscale * ((double) rand());
-        rsum = (r1+r2);
-        xval[i] = rsum - 6.0;
-        xvalf[i] = (float) xval[i];
-        err += xval[i];
-        sumerr += xval[i]*xval[i];
-    }
-    err /= (double) num;
-    sumerr /= (double) num;
-    printf("time/set for %d x-values : %8.4gus\n", num, wallclock(&start)/num);
     xscale = 1.0/(rep*num);
 
-    RUN_LOOP(xval,res0,erf,double);
-    printf("numreps %d\n", rep);
-
-    RUN_LOOP(xval,res1,__builtin_erf,double);
-    DOUBLE_ERROR(res0,res1);
-
-    RUN_LOOP(xval,res2,(1.0) - erfc,double);
-    DOUBLE_ERROR(res0,res2);
-#if 0
-    RUN_LOOP(xval,res3,fm_log2_alt,double);
-    DOUBLE_ERROR(res0,res3);
-#endif
-
-    RUN_LOOP(xval,res0,erfc,double);
-    printf("numreps %d\n", rep);
+    if (selected("special")) {
+        puts("-------------------------\ntesting special cases for log() functions");
+        {
+            const double sval[] = {0.0, -0.0, -1.0, 1.0/0.0, -1.0/0.0, 0.0/0.0,
+                                   4.9406564584124654e-324, 2.2250738585072009e-308};
+            const float svalf[] = {0.0f, -0.0f, -1.0f, 1.0f/0.0f, -1.0f/0.0f,
+                                   0.0f/0.0f, 1.40129846e-45f, 1.17549421e-38f};
+
+            for (i=0; i < (int)(sizeof(sval)/sizeof(double)); ++i)
+                printf("log(% .6g) = % .15g  fm_log_ieee(% .6g) = % .15g\n",
+                       sval[i], log(sval[i]), sval[i], fm_log_ieee(sval[i]));
+            for (i=0; i < (int)(sizeof(svalf)/sizeof(float)); ++i)
+                printf("logf(% .6g) = % .8g  fm_logf_ieee(% .6g) = % .8g\n",
+                       svalf[i], logf(svalf[i]), svalf[i], fm_logf_ieee(svalf[i]));
+        }
+
+        puts("testing special cases for the polynomial exp() functions");
+        {
+            const double sval[] = {0.0/0.0, -(0.0/0.0), 1.0/0.0, -1.0/0.0,
+                                   2000.0, -2000.0, 1.0, -1.0};
+            const int nsval = (int)(sizeof(sval)/sizeof(double));
+
+            /* NaN, inf and overflow must match libm in the scalar
+               function and in the vectorized batch function alike.
+               the batch functions get enough arguments to run their
+               vector loops. the scalar default functions use a
+               different kernel without a range check, so only NaN,
+               the first ns values, is checked for them. */
+#define CHECK_ESPECIAL(func,ref,ns)                                      \
+            for (i=0, d=0; i < k; ++i) {                                    \
+                xval[i] = sval[i % nsval];                                  \
+                if ((i % nsval < (ns))                                      \
+                    && (fpclass(func(xval[i])) != fpclass(ref(xval[i]))))   \
+                    ++d;                                                    \
+            }                                                               \
+            func ## _v(xval,res2,k);                                        \
+            for (i=0, j=0; i < k; ++i)                                      \
+                if (fpclass(res2[i]) != fpclass(ref(xval[i]))) ++j;         \
+            printf(#func "() %s for NaN%s, " #func "_v() %s for NaN "       \
+                   "and inf\n", d ? "FAILS" : "passes",                     \
+                   ((ns) < nsval) ? "" : " and inf", j ? "FAILS" : "passes")
+
+            k = (num < 64) ? num : 64;
+            CHECK_ESPECIAL(fm_exp2_poly,exp2,nsval);
+            CHECK_ESPECIAL(fm_exp_poly,exp,nsval);
+            CHECK_ESPECIAL(fm_exp10_poly,exp10,nsval);
+            CHECK_ESPECIAL(fm_exp2,exp2,2);
+            CHECK_ESPECIAL(fm_exp,exp,2);
+            CHECK_ESPECIAL(fm_exp10,exp10,2);
+        }
+    }
 
-    RUN_LOOP(xval,res1,__builtin_erfc,double);
-    DOUBLE_ERROR(res0,res1);
+    if (selected("half")) {
+        puts("-------------------------\ntesting half precision batch functions");
+        {
+            unsigned short *xh, *yh;
+
+            GRABMEM(xh,unsigned short);
+            GRABMEM(yh,unsigned short);
+
+            /* time a half precision batch function and compare to the single
+               precision reference ref() applied to the rounded arguments. */
+#define RUN_HLOOP(func,fmt,ref)                                 \
+            start = wallclock(NULL);                                \
+            for (j=0; j < rep; ++j)                                 \
+                func(xh,yh,num);                                    \
+            printf("time for% 20s(): %8.4fns/element  ",            \
+                   #func, 1000.0*xscale*wallclock(&start));         \
+            fm_ ## fmt ## _to_float_v(yh,res2f,num);                \
+            for (i=0; i < num; ++i) res1f[i] = ref(res0f[i]);       \
+            DOUBLE_ERROR(res1f,res2f)
+
+            /* same for the conversion to single precision, evaluation
+               with a single precision kernel, and conversion back. */
+#define RUN_HCONV(func,fmt)                                     \
+            start = wallclock(NULL);                                \
+            for (j=0; j < rep; ++j) {                               \
+                fm_ ## fmt ## _to_float_v(xh,res3f,num);            \
+                for (i=0; i < num; ++i)                             \
+                    res3f[i] = func(res3f[i]);                      \
+                fm_float_to_ ## fmt ## _v(res3f,yh,num);            \
+            }                                                       \
+            printf("time for% 20s(): %8.4fns/element\n",            \
+                   #fmt "+" #func, 1000.0*xscale*wallclock(&start))
+
+#define SIGMOIDF(x) (1.0f/(1.0f + expf(-(x))))
+
+            /* random numbers distributed between -8.0 and 8.0, so that
+               e**x stays within the normalized half precision range */
+            for (i=0; i < num; ++i)
+                xvalf[i] = 16.0f * ((float) rand()) / ((float) RAND_MAX) - 8.0f;
+
+            fm_float_to_f16_v(xvalf,xh,num);
+            fm_f16_to_float_v(xh,res0f,num);
+            RUN_HCONV(fm_expf,f16);
+            RUN_HLOOP(fm_exp_f16_v,f16,expf);
+            RUN_HLOOP(fm_sigmoid_f16_v,f16,SIGMOIDF);
+
+            fm_float_to_bf16_v(xvalf,xh,num);
+            fm_bf16_to_float_v(xh,res0f,num);
+            RUN_HCONV(fm_expf,bf16);
+            RUN_HLOOP(fm_exp_bf16_v,bf16,expf);
+            RUN_HLOOP(fm_sigmoid_bf16_v,bf16,SIGMOIDF);
+
+            for (i=0; i < num; ++i)
+                xvalf[i] = expf(xvalf[i]);
+
+            fm_float_to_f16_v(xvalf,xh,num);
+            fm_f16_to_float_v(xh,res0f,num);
+            RUN_HCONV(fm_logf,f16);
+            RUN_HLOOP(fm_log_f16_v,f16,logf);
+
+            fm_float_to_bf16_v(xvalf,xh,num);
+            fm_bf16_to_float_v(xh,res0f,num);
+            RUN_HCONV(fm_logf,bf16);
+            RUN_HLOOP(fm_log_bf16_v,bf16,logf);
+
+            free(xh);
+            free(yh);
+        }
+        {
+            /* exhaustive check over all finite arguments (positive ones
+               for log) against the double precision result rounded to
+               half precision. reports the maximum error in units in the
+               last place and the number of results that are not
+               correctly rounded. */
+            const int nall = 65536;
+            unsigned short *xa, *ya, *ra;
+            float *xaf, *raf;
+            int m, d, maxulp, nbad;
+
+            posix_memalign((void **)&xa, _FM_ALIGN, nall*sizeof(unsigned short));
+            posix_memalign((void **)&ya, _FM_ALIGN, nall*sizeof(unsigned short));
+            posix_memalign((void **)&ra, _FM_ALIGN, nall*sizeof(unsigned short));
+            posix_memalign((void **)&xaf, _FM_ALIGN, nall*sizeof(float));
+            posix_memalign((void **)&raf, _FM_ALIGN, nall*sizeof(float));
+
+            /* distance of two half precision numbers in units in the last
+               place, by mapping the sign-magnitude bit patterns to a
+               monotonic integer scale. the tester is compiled with
+               -ffast-math, so NaN and inf are detected from the bits. */
+#define HALF_ORD(h) (((h) & 0x8000) ? -((int)((h) & 0x7fff)) : (int)(h))
+#define HALF_NAN(h,emask) ((((h) & (emask)) == (emask)) && ((h) & ~(emask) & 0x7fff))
+
+#define CHECK_HALL(func,fmt,ref,emask,pos)                              \
+            for (i=0, m=0; i < nall; ++i) {                                 \
+                if ((i & (emask)) == (emask)) continue;                     \
+                if (pos && (((i & 0x8000) != 0) || ((i & 0x7fff) == 0)))    \
+                    continue;                                               \
+                xa[m++] = (unsigned short) i;                               \
+            }                                                               \
+            fm_ ## fmt ## _to_float_v(xa,xaf,m);                            \
+            for (i=0; i < m; ++i)                                           \
+                raf[i] = (float) ref((double) xaf[i]);                      \
+            fm_float_to_ ## fmt ## _v(raf,ra,m);                            \
+            func(xa,ya,m);                                                  \
+            for (i=0, maxulp=0, nbad=0; i < m; ++i) {                       \
+                if (HALF_NAN(ya[i],emask) || HALF_NAN(ra[i],emask))         \
+                    d = nall;                                               \
+                else                                                        \
+                    d = abs(HALF_ORD(ya[i]) - HALF_ORD(ra[i]));             \
+                if (d > maxulp) maxulp = d;                                 \
+                if (d > 0) ++nbad;                                          \
+            }                                                               \
+            printf("check  % 20s(): %6d arguments  max err %5d ulp  "      \
+                   "%6d not correctly rounded\n", #func, m, maxulp, nbad)
+
+#define SIGMOID(x) (1.0/(1.0 + exp(-(x))))
+
+            CHECK_HALL(fm_exp_f16_v,f16,exp,0x7c00,0);
+            CHECK_HALL(fm_log_f16_v,f16,log,0x7c00,1);
+            CHECK_HALL(fm_sigmoid_f16_v,f16,SIGMOID,0x7c00,0);
+            CHECK_HALL(fm_exp_bf16_v,bf16,exp,0x7f80,0);
+            CHECK_HALL(fm_log_bf16_v,bf16,log,0x7f80,1);
+            CHECK_HALL(fm_sigmoid_bf16_v,bf16,SIGMOID,0x7f80,0);
+
+            free(xa);
+            free(ya);
+            free(ra);
+            free(xaf);
+            free(raf);
+        }
+    }
 
-    RUN_LOOP(xval,res2,(1.0) - erf,double);
-    DOUBLE_ERROR(res0,res2);
+    if (selected("bandwidth")) {
+        puts("-------------------------\ntesting memory bandwidth of batch functions");
+        {
+            /* number of elements for the in-cache and out-of-cache tests */
+            const int bwsize[2] = {4096, 1<<25};
+            double *xb, *yb, t;
+            int k, nb, nrep;
+
+            posix_memalign((void **)&xb, 64, bwsize[1]*sizeof(double));
+            posix_memalign((void **)&yb, 64, bwsize[1]*sizeof(double));
+            for (i=0; i < bwsize[1]; ++i) {
+                xb[i] = 1.0 + ((double) (i & 1023)) / 128.0;
+                yb[i] = 0.0;
+            }
+
+            /* process the same total number of elements for each size and
+               count 16 bytes of memory traffic (load and store) per element */
+#define RUN_BWLOOP(func)                                                \
+            for (k=0; k < 2; ++k) {                                         \
+                nb = bwsize[k];                                             \
+                nrep = 2*(bwsize[1]/nb);                                    \
+                func(xb,yb,nb);                                             \
+                start = wallclock(NULL);                                    \
+                for (j=0; j < nrep; ++j)                                    \
+                    func(xb,yb,nb);                                         \
+                t = wallclock(&start);                                      \
+                printf("bandwidth % 20s(): %9d elements %8.3f GB/s  "     \
+                       "%8.4fns/element\n", #func, nb,                      \
+                       16.0*nb*nrep/(1.0e3*t), 1.0e3*t/((double)nb*nrep));  \
+            }
+
+            RUN_BWLOOP(fm_exp_v);
+            RUN_BWLOOP(fm_exp_v_stream);
+            RUN_BWLOOP(fm_log_v);
+            RUN_BWLOOP(fm_log_v_stream);
+
+            printf("using %d threads for the _mt functions\n",
+                   fm_get_num_threads());
+            RUN_BWLOOP(fm_exp_v_mt);
+            RUN_BWLOOP(fm_log_v_mt);
+
+            /* the multi-threaded result must be identical */
+            fm_log_v(xb,xb+bwsize[1]/2,bwsize[1]/2);
+            fm_log_v_mt(xb,yb,bwsize[1]/2);
+            for (i=0; i < bwsize[1]/2; ++i)
+                if (yb[i] != xb[bwsize[1]/2+i]) break;
+            printf("fm_log_v_mt() %s fm_log_v()\n",
+                   (i == bwsize[1]/2) ? "matches" : "DIFFERS from");
+
+            free(xb);
+            free(yb);
+        }
+    }
 
-    RUN_LOOP(xval,res3,fm_erfc,double);
-    DOUBLE_ERROR(res0,res3);
+    if (selected("omp")) {
+        puts("-------------------------\ntesting OpenMP batch functions");
+        xscale = 1.0/(rep*num);
+        {
+            double *xo, *yo, *yr;
+            int nthr = 1;
+
+            GRABMEM(xo,double);
+            GRABMEM(yo,double);
+            GRABMEM(yr,double);
+
+            /* positive arguments, so the same data works for log */
+            for (i=0; i < num; ++i)
+                xo[i] = 20.0 * ((double) rand()) / ((double) RAND_MAX) + 1.0e-3;
+
+#if defined(_OPENMP)
+#pragma omp parallel
+            {
+#pragma omp master
+                nthr = omp_get_num_threads();
+            }
+#endif
+            printf("using %d OpenMP threads for the _omp functions\n", nthr);
+
+            /* all threads of a parallel region call the _omp function,
+               which shares the elements among them. the result must be
+               identical to that of the plain batch function. */
+#define RUN_OLOOP(name)                                                 \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _v(xo,yr,num);                                      \
+            printf("time for % 20s(): %8.4fns/element\n", #name "_v",       \
+                   1000.0*xscale*wallclock(&start));                        \
+            start = wallclock(NULL);                                        \
+            _Pragma("omp parallel private(j)")                              \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _v_omp(xo,yo,num);                                  \
+            printf("time for % 20s(): %8.4fns/element  ", #name "_v_omp",   \
+                   1000.0*xscale*wallclock(&start));                        \
+            for (i=0; i < num; ++i)                                         \
+                if (yo[i] != yr[i]) break;                                  \
+            printf("%s " #name "_v()\n",                                    \
+                   (i == num) ? "matches" : "DIFFERS from")
+
+            RUN_OLOOP(fm_exp2);
+            RUN_OLOOP(fm_exp);
+            RUN_OLOOP(fm_exp10);
+            RUN_OLOOP(fm_log2);
+            RUN_OLOOP(fm_log);
+            RUN_OLOOP(fm_log10);
+
+            free(xo);
+            free(yo);
+            free(yr);
+        }
+    }
 
+    if (selected("strided")) {
+        puts("-------------------------\ntesting strided and indexed batch functions");
+        xscale = 1.0/(rep*num);
+        {
+            /* array of structures with 4 doubles per element. the input is
+               in field 0, the results are written to fields 1 to 3. */
+            const int nf = 4;
+            double *aos;
+            int *idx, k;
+
+            posix_memalign((void **)&aos, _FM_ALIGN, nf*num*sizeof(double));
+            posix_memalign((void **)&idx, _FM_ALIGN, num*sizeof(int));
+            for (i=0; i < num; ++i) {
+                aos[nf*i] = 0.1 + 5.0 * ((double) rand()) / ((double) RAND_MAX);
+                aos[nf*i+1] = aos[nf*i+2] = aos[nf*i+3] = 0.0;
+                idx[i] = i;
+            }
+            /* random permutation of the elements for the indexed access */
+            for (i=num-1; i > 0; --i) {
+                j = rand() % (i+1);
+                k = idx[i]; idx[i] = idx[j]; idx[j] = k;
+            }
+            for (i=0; i < num; ++i) idx[i] *= nf;
+
+            /* time copy-in, contiguous batch evaluation and copy-out as the
+               reference, then the strided and the indexed functions on the
+               same data. batch is a statement computing res1 from res0. */
+#define RUN_SLOOP(name,batch)                                           \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j) {                                       \
+                for (i=0; i < num; ++i) res0[i] = aos[nf*i];                \
+                batch;                                                      \
+                for (i=0; i < num; ++i) aos[nf*i+3] = res1[i];              \
+            }                                                               \
+            printf("time for % 20s(): %8.4fns/element\n", "copy+" #name,   \
+                   1000.0*xscale*wallclock(&start));                        \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _strided(aos,nf,aos+1,nf,num);                      \
+            printf("time for % 20s(): %8.4fns/element  ", #name "_strided", \
+                   1000.0*xscale*wallclock(&start));                        \
+            for (i=0; i < num; ++i) res2[i] = aos[nf*i+1];                  \
+            DOUBLE_ERROR(res1,res2);                                        \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _idx(aos,idx,aos+2,num);                            \
+            printf("time for % 20s(): %8.4fns/element  ", #name "_idx",     \
+                   1000.0*xscale*wallclock(&start));                        \
+            for (i=0; i < num; ++i) res2[i] = aos[nf*i+2];                  \
+            DOUBLE_ERROR(res1,res2)
+
+            RUN_SLOOP(fm_exp,fm_exp_v(res0,res1,num));
+            RUN_SLOOP(fm_log,fm_log_v(res0,res1,num));
+            RUN_SLOOP(fm_erfc,for (k=0; k < num; ++k) res1[k] = fm_erfc_fma(res0[k]));
+
+            free(aos);
+            free(idx);
+        }
+    }
 
-    RUN_LOOP(xvalf,res0f,erff,float);
-    printf("numreps %d\n", rep);
+    if (selected("masked")) {
+        puts("-------------------------\ntesting masked batch functions");
+        xscale = 1.0/(rep*num);
+        {
+            const int pct[3] = {10, 50, 90};
+            unsigned char *mask;
+            int k, nact;
+
+            GRABMEM(mask,unsigned char);
+            for (i=0; i < num; ++i)
+                xval[i] = 0.1 + 5.0 * ((double) rand()) / ((double) RAND_MAX);
+
+            /* time the masked function and a loop with a branch per element
+               for each active fraction. the inactive elements of the output
+               are preset to -1.0 and must not be changed. */
+#define RUN_MLOOP(name,scalar)                                          \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                for (i=0; i < num; ++i)                                     \
+                    if (mask[i]) res1[i] = scalar(xval[i]);                 \
+            printf("time for % 20s(): %3d%% active %8.4fns/element\n",      \
+                   "if+" #scalar, pct[k], 1000.0*xscale*wallclock(&start)); \
+            for (i=0; i < num; ++i) res2[i] = -1.0;                         \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _mask(xval,mask,res2,num);                          \
+            printf("time for % 20s(): %3d%% active %8.4fns/element  ",       \
+                   #name "_mask", pct[k], 1000.0*xscale*wallclock(&start)); \
+            for (i=0; i < num; ++i)                                         \
+                res1[i] = mask[i] ? scalar(xval[i]) : -1.0;                 \
+            DOUBLE_ERROR(res1,res2)
+
+            for (k=0; k < 3; ++k) {
+                for (i=0, nact=0; i < num; ++i) {
+                    mask[i] = (rand() % 100) < pct[k];
+                    nact += mask[i];
+                }
+                printf("%d of %d elements active\n", nact, num);
+                RUN_MLOOP(fm_exp,fm_exp);
+                RUN_MLOOP(fm_log,fm_log);
+                RUN_MLOOP(fm_erfc,fm_erfc_fma);
+            }
+            start = wallclock(NULL);
+            for (j=0; j < rep; ++j)
+                fm_exp_v(xval,res2,num);
+            printf("time for % 20s(): all elements %8.4fns/element\n",
+                   "fm_exp_v", 1000.0*xscale*wallclock(&start));
+            start = wallclock(NULL);
+            for (j=0; j < rep; ++j)
+                fm_log_v(xval,res2,num);
+            printf("time for % 20s(): all elements %8.4fns/element\n",
+                   "fm_log_v", 1000.0*xscale*wallclock(&start));
+
+            free(mask);
+        }
+    }
 
-    RUN_LOOP(xvalf,res1f,__builtin_erff,float);
-    DOUBLE_ERROR(res0f,res1f);
+    if (selected("fused")) {
+        puts("-------------------------\ntesting fused accumulating batch functions");
+        xscale = 1.0/(rep*num);
+        {
+            int k;
+
+            /* time y[i] += a*f(b*x[i]+c) as three passes (scale, batch
+               function, accumulate) and with the fused function. batch is
+               a statement computing res1 from res0. */
+#define RUN_ALOOP(name,batch,a,b,c)                                     \
+            memset(res2, 0, num*sizeof(double));                            \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j) {                                       \
+                for (i=0; i < num; ++i) res0[i] = (b)*xval[i] + (c);        \
+                batch;                                                      \
+                for (i=0; i < num; ++i) res2[i] += (a)*res1[i];             \
+            }                                                               \
+            printf("time for % 20s(): %8.4fns/element\n", "3pass " #name,   \
+                   1000.0*xscale*wallclock(&start));                        \
+            memset(res3, 0, num*sizeof(double));                            \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                name ## _axpby(a,b,c,xval,res3,num);                        \
+            printf("time for % 20s(): %8.4fns/element  ", #name "_axpby",   \
+                   1000.0*xscale*wallclock(&start));                        \
+            DOUBLE_ERROR(res2,res3)
+
+            for (i=0; i < num; ++i)
+                xval[i] = 0.1 + 5.0 * ((double) rand()) / ((double) RAND_MAX);
+
+            RUN_ALOOP(fm_exp2,fm_exp2_v(res0,res1,num),0.5,-1.5,0.25);
+            RUN_ALOOP(fm_exp,fm_exp_v(res0,res1,num),0.5,-1.5,0.25);
+            RUN_ALOOP(fm_log,fm_log_v(res0,res1,num),0.5,1.5,0.25);
+            RUN_ALOOP(fm_erfc,for (k=0; k < num; ++k) res1[k] = fm_erfc_fma(res0[k]),
+                      0.5,0.5,-0.5);
+        }
+    }
 
-    RUN_LOOP(xvalf,res2f,1.0f-erfcf,float);
-    DOUBLE_ERROR(res0f,res2f);
-#if 0
-    RUN_LOOP(xvalf,res3f,fm_log2f_alt,float);
-    DOUBLE_ERROR(res0f,res3f);
-#endif
-    RUN_LOOP(xvalf,res0f,erfcf,float);
-    printf("numreps %d\n", rep);
+    if (selected("sum_log")) {
+        puts("-------------------------\ntesting sum of logarithms");
+        xscale = 1.0/(rep*num);
+        {
+            double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0;
+            float sumf = 0.0f;
+
+            /* probabilities in ]0.0:1.0] */
+            for (i=0; i < num; ++i) {
+                xval[i] = (1.0 + (double) rand()) / (1.0 + (double) RAND_MAX);
+                xvalf[i] = (float) xval[i];
+            }
+
+            /* sum of individual logarithms and of the product */
+#define RUN_SUMLOOP(sum,expr,name)                                      \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j) {                                       \
+                expr;                                                       \
+            }                                                               \
+            printf("time for % 20s(): %8.4fns/element  sum %.15g\n", name,  \
+                   1000.0*xscale*wallclock(&start), sum)
+
+            RUN_SUMLOOP(sum0,for (sum0=0.0, i=0; i < num; ++i)
+                        sum0 += log(xval[i]),"sum of log");
+            RUN_SUMLOOP(sum1,for (sum1=0.0, i=0; i < num; ++i)
+                        sum1 += fm_log(xval[i]),"sum of fm_log");
+            RUN_SUMLOOP(sum2,sum2 = fm_sum_log(xval,num),"fm_sum_log");
+            printf("relerr fm_sum_log: %.6g\n", fabs((sum2-sum0)/sum0));
+            RUN_SUMLOOP(sumf,sumf = fm_sum_logf(xvalf,num),"fm_sum_logf");
+            printf("relerr fm_sum_logf: %.6g\n", fabs((sumf-sum0)/sum0));
+        }
+    }
 
-    RUN_LOOP(xvalf,res1f,__builtin_erfcf,float);
-    DOUBLE_ERROR(res0f,res1f);
+    if (selected("log_int")) {
+        puts("-------------------------\ntesting logarithms of integers");
+        xscale = 1.0/(rep*num);
+        {
+            uint32_t *cnt;
+            int k;
+
+            GRABMEM(cnt,uint32_t);
+
+            /* time the conversion to double and a call per element against
+               the table functions. the second set of counts has 1% values
+               outside of the table. */
+#define RUN_ILOOP(func,expr,ref,res)                                    \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j) {                                       \
+                expr;                                                       \
+            }                                                               \
+            printf("time for % 20s(): %8.4fns/element  ", #func,             \
+                   1000.0*xscale*wallclock(&start));                        \
+            DOUBLE_ERROR(ref,res)
+
+            /* the scalar and the batch functions use the same table and
+               kernel, so their results must be identical */
+#define CHECK_ISAME(func)                                               \
+            for (i=0; i < num; ++i)                                         \
+                if (res2[i] != res3[i]) break;                              \
+            printf(#func "() %s " #func "_v()\n",                           \
+                   (i == num) ? "matches" : "DIFFERS from")
+
+            for (k=0; k < 2; ++k) {
+                for (i=0; i < num; ++i) {
+                    cnt[i] = 1 + rand() % 1000;
+                    if ((k == 1) && ((rand() % 100) == 0))
+                        cnt[i] = 100000 + rand();
+                }
+                printf("counts up to %s\n", k ? "2**31" : "1000");
+                for (i=0; i < num; ++i) res0[i] = log((double) cnt[i]);
+                RUN_ILOOP(fm_log,for (i=0; i < num; ++i)
+                          res1[i] = fm_log((double) cnt[i]),res0,res1);
+                RUN_ILOOP(fm_log_u32,for (i=0; i < num; ++i)
+                          res2[i] = fm_log_u32(cnt[i]),res0,res2);
+                RUN_ILOOP(fm_log_u32_v,fm_log_u32_v(cnt,res3,num),res0,res3);
+                CHECK_ISAME(fm_log_u32);
+                for (i=0; i < num; ++i) res0[i] *= (double) cnt[i];
+                RUN_ILOOP(fm_nlogn_u32,for (i=0; i < num; ++i)
+                          res2[i] = fm_nlogn_u32(cnt[i]),res0,res2);
+                RUN_ILOOP(fm_nlogn_u32_v,fm_nlogn_u32_v(cnt,res3,num),res0,res3);
+                CHECK_ISAME(fm_nlogn_u32);
+            }
+            free(cnt);
+        }
+    }
 
-    RUN_LOOP(xvalf,res2f,1.0f-erff,float);
-    DOUBLE_ERROR(res0f,res2f);
+    if (selected("table")) {
+        puts("-------------------------\ntesting runtime spline tables");
+        xscale = 1.0/(rep*num);
+        {
+            fm_table *tbl;
+            int bits;
+
+            for (i=0; i < num; ++i)
+                xval[i] = 1.0 + 9.0 * ((double) rand()) / ((double) RAND_MAX);
+
+            start = wallclock(NULL);
+            for (j=0; j < rep; ++j)
+                for (i=0; i < num; ++i)
+                    res0[i] = coul_erfc(xval[i]);
+            printf("time for % 20s(): %8.4fns/element\n", "coul_erfc",
+                   1000.0*xscale*wallclock(&start));
+            for (bits=8; bits <= 16; bits += 4) {
+                tbl = fm_table_create(coul_erfc, 1.0, 10.0, bits);
+                if (tbl == NULL) {
+                    puts("fm_table_create() failed");
+                    continue;
+                }
+                printf("spline table with %d bits for erfc(0.3*r)/r in [1:10]\n",
+                       bits);
+                start = wallclock(NULL);
+                for (j=0; j < rep; ++j)
+                    for (i=0; i < num; ++i)
+                        res1[i] = fm_table_eval(tbl,xval[i]);
+                printf("time for % 20s(): %8.4fns/element  ", "fm_table_eval",
+                       1000.0*xscale*wallclock(&start));
+                DOUBLE_ERROR(res0,res1);
+                start = wallclock(NULL);
+                for (j=0; j < rep; ++j)
+                    fm_table_eval_v(tbl,xval,res2,num);
+                printf("time for % 20s(): %8.4fns/element  ", "fm_table_eval_v",
+                       1000.0*xscale*wallclock(&start));
+                DOUBLE_ERROR(res0,res2);
+                fm_table_free(tbl);
+            }
+
+            /* arguments outside of the table are extrapolated linearly,
+               also where (x-lo)/delta does not fit into an int */
+            {
+                const double xo[8] = {-1.0e12, -5.0, 0.5, 1.0,
+                                      10.0, 11.0, 3.0e9, 1.0e300};
+                double yo[8];
+
+                tbl = fm_table_create(coul_erfc, 1.0, 10.0, 16);
+                if (tbl != NULL) {
+                    fm_table_eval_v(tbl,xo,yo,8);
+                    for (i=0; i < 8; ++i)
+                        printf("fm_table_eval(% .6g) = % .10g  "
+                               "fm_table_eval_v() %s\n", xo[i],
+                               fm_table_eval(tbl,xo[i]),
+                               (yo[i] == fm_table_eval(tbl,xo[i]))
+                               ? "matches" : "DIFFERS");
+                    fm_table_free(tbl);
+                }
+            }
+        }
+    }
 
-    RUN_LOOP(xvalf,res3f,fm_erfcf,float);
-    DOUBLE_ERROR(res0f,res3f);
+    if (selected("cache")) {
+        puts("-------------------------\ntesting cache behavior of double precision log()");
+        xscale = 1.0/(rep*num);
+        {
+            /* simulated cache pressure: every evaluation is accompanied by
+               reading two new cache lines of a 256 kB array, as in a loop
+               that also streams particle data. the array fits into the L2
+               cache, but it evicts the lookup tables from the L1 cache. */
+            const int npress = 1<<15;
+            double *press, psum = 0.0;
+            int k = 0;
+
+            posix_memalign((void **)&press, 64, npress*sizeof(double));
+            for (i=0; i < npress; ++i) press[i] = 1.0e-10 * (double) (i & 255);
+
+            /* arguments log-uniformly distributed in [1e-6:1e6] */
+            for (i=0; i < num; ++i)
+                xval[i] = exp(27.6 * ((double) rand()) / ((double) RAND_MAX) - 13.8);
+            for (i=0; i < num; ++i) res0[i] = log(xval[i]);
+
+#define RUN_CLOOP(func)                                                 \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                for (i=0; i < num; ++i)                                     \
+                    res1[i] = func(xval[i]);                                \
+            printf("time for % 20s(): warm %8.4fns/element  ", #func,       \
+                   1000.0*xscale*wallclock(&start));                        \
+            DOUBLE_ERROR(res0,res1);                                        \
+            start = wallclock(NULL);                                        \
+            for (j=0; j < rep; ++j)                                         \
+                for (i=0; i < num; ++i) {                                   \
+                    psum += press[k] + press[k+8];                          \
+                    k = (k + 16) & (npress - 1);                            \
+                    res1[i] = func(xval[i]);                                \
+                }                                                           \
+            printf("time for % 20s(): cold %8.4fns/element\n", #func,       \
+                   1000.0*xscale*wallclock(&start))
+
+            start = wallclock(NULL);
+            for (j=0; j < rep; ++j)
+                for (i=0; i < num; ++i) {
+                    psum += press[k] + press[k+8];
+                    k = (k + 16) & (npress - 1);
+                    res1[i] = xval[i];
+                }
+            printf("time for % 20s(): cold %8.4fns/element\n", "pressure only",
+                   1000.0*xscale*wallclock(&start));
+
+            RUN_CLOOP(log);
+            RUN_CLOOP(fm_log);
+            RUN_CLOOP(fm_log_poly);
+            RUN_CLOOP(fm_log_compact);
+            printf("(checksum %g)\n", psum);
+            free(press);
+        }
+    }
 
-    
     free(xval);
     free(res0);
     free(res1);
@@ -384,6 +1856,7 @@ int main(int argc, char **argv)
     free(res1f);
     free(res2f);
     free(res3f);
+    if (outfp) out_footer();
 
     return 0;
 
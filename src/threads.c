@@ -0,0 +1,244 @@
+/* 
+   Copyright (c) 2012,2013   Axel Kohlmeyer <akohlmey@gmail.com> 
+   All rights reserved.
+
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   * Redistributions of source code must retain the above copyright
+     notice, this list of conditions and the following disclaimer.
+   * Redistributions in binary form must reproduce the above copyright
+     notice, this list of conditions and the following disclaimer in the
+     documentation and/or other materials provided with the distribution.
+   * Neither the name of the <organization> nor the
+     names of its contributors may be used to endorse or promote products
+     derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* multi-threaded batch functions using a persistent pool of worker
+ * threads.
+ *
+ * the worker threads are created on the first call that needs them
+ * and then wait for work. the calling thread takes part in the work.
+ * each thread processes a contiguous part of the arrays, so that the
+ * same thread touches the same memory pages in subsequent calls (which
+ * keeps the data local on NUMA machines, if it was initialized in the
+ * same way), in chunks of FM_MT_CHUNK elements, which fit into the
+ * per-core caches. batches smaller than FM_MT_THRESHOLD elements are
+ * processed by the calling thread only.
+ *
+ * the number of threads is taken from the FM_NUM_THREADS environment
+ * variable or the number of online CPUs, and can be changed with
+ * fm_set_num_threads(). when the pool is busy with a call from another
+ * thread, the batch is processed by the calling thread.
+ */
+
+#include "fastermath.h"
+#include "fm_internal.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifndef FM_MT_THRESHOLD
+#define FM_MT_THRESHOLD (1<<16)
+#endif
+#ifndef FM_MT_CHUNK
+#define FM_MT_CHUNK (1<<14)
+#endif
+
+typedef void (*fm_batch_func_t)(const double *, double *, size_t);
+
+static struct {
+    pthread_mutex_t lock;       /* protects the data below */
+    pthread_cond_t  work;       /* signals a new batch */
+    pthread_cond_t  done;       /* signals completion of a batch */
+    pthread_mutex_t busy;       /* held during a multi-threaded call */
+    pthread_once_t  once;
+    unsigned long   gen;        /* batch counter */
+    int nthreads;               /* number of threads to use. not under
+                                   the lock, but only accessed atomically */
+    int nworkers;               /* number of worker threads started */
+    int nactive;                /* number of threads for current batch */
+    int pending;                /* workers still busy with current batch */
+    fm_batch_func_t func;
+    const double *x;
+    double *y;
+    size_t n;
+} fm_pool = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_ONCE_INIT, 0, 1, 0, 0, 0, NULL, NULL, NULL, 0
+};
+
+typedef struct {
+    int id;
+    unsigned long gen;
+} fm_worker_arg_t;
+
+/* process the part of thread id out of nt in cache sized chunks */
+static void fm_pool_run(fm_batch_func_t func, const double *x, double *y,
+                        size_t n, int id, int nt)
+{
+    size_t i, m, end;
+
+    i   = (size_t) (((unsigned long long) n * id) / nt);
+    end = (size_t) (((unsigned long long) n * (id+1)) / nt);
+
+    for (; i < end; i += FM_MT_CHUNK) {
+        m = (end - i < FM_MT_CHUNK) ? (end - i) : FM_MT_CHUNK;
+        func(x+i, y+i, m);
+    }
+}
+
+static void *fm_pool_worker(void *ptr)
+{
+    fm_worker_arg_t *arg = (fm_worker_arg_t *) ptr;
+    const int id = arg->id;
+    unsigned long gen = arg->gen;
+
+    free(arg);
+    pthread_mutex_lock(&fm_pool.lock);
+    for (;;) {
+        while (fm_pool.gen == gen)
+            pthread_cond_wait(&fm_pool.work, &fm_pool.lock);
+        gen = fm_pool.gen;
+        if (id < fm_pool.nactive) {
+            fm_batch_func_t func = fm_pool.func;
+            const double *x = fm_pool.x;
+            double *y = fm_pool.y;
+            const size_t n = fm_pool.n;
+            const int nt = fm_pool.nactive;
+
+            pthread_mutex_unlock(&fm_pool.lock);
+            fm_pool_run(func, x, y, n, id, nt);
+            pthread_mutex_lock(&fm_pool.lock);
+            if (--fm_pool.pending == 0)
+                pthread_cond_signal(&fm_pool.done);
+        }
+    }
+    return NULL;
+}
+
+/* start worker threads up to nt-1. must be called with the lock held. */
+static void fm_pool_grow(int nt)
+{
+    pthread_attr_t attr;
+    pthread_t tid;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    while (fm_pool.nworkers < nt-1) {
+        fm_worker_arg_t *arg = (fm_worker_arg_t *) malloc(sizeof(fm_worker_arg_t));
+        if (arg == NULL) break;
+        arg->id = fm_pool.nworkers+1;
+        arg->gen = fm_pool.gen;
+        if (pthread_create(&tid, &attr, fm_pool_worker, arg) != 0) {
+            free(arg);
+            break;
+        }
+        ++fm_pool.nworkers;
+    }
+    pthread_attr_destroy(&attr);
+}
+
+static void fm_pool_init(void)
+{
+    const char *env = getenv("FM_NUM_THREADS");
+    long nt = 0;
+
+    if (env) nt = strtol(env, NULL, 10);
+#if defined(_SC_NPROCESSORS_ONLN)
+    if (nt < 1) nt = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    __atomic_store_n(&fm_pool.nthreads, (nt < 1) ? 1 : (int) nt,
+                     __ATOMIC_RELAXED);
+}
+
+void fm_set_num_threads(int nt)
+{
+    pthread_once(&fm_pool.once, fm_pool_init);
+    __atomic_store_n(&fm_pool.nthreads, (nt < 1) ? 1 : nt, __ATOMIC_RELAXED);
+}
+
+int fm_get_num_threads(void)
+{
+    pthread_once(&fm_pool.once, fm_pool_init);
+    return __atomic_load_n(&fm_pool.nthreads, __ATOMIC_RELAXED);
+}
+
+static void fm_batch_mt(fm_batch_func_t func, const double *x, double *y,
+                        size_t n)
+{
+    int nt;
+
+    pthread_once(&fm_pool.once, fm_pool_init);
+
+    /* each thread gets at least FM_MT_THRESHOLD elements. the number
+       of threads is read atomically and not under the lock, so that
+       calls that are too small to be split do not touch the lock. a
+       concurrent fm_set_num_threads() applies to the next call. */
+    nt = __atomic_load_n(&fm_pool.nthreads, __ATOMIC_RELAXED);
+    if ((size_t) nt > n / FM_MT_THRESHOLD) nt = (int) (n / FM_MT_THRESHOLD);
+
+    if ((nt < 2) || (pthread_mutex_trylock(&fm_pool.busy) != 0)) {
+        func(x, y, n);
+        return;
+    }
+
+    pthread_mutex_lock(&fm_pool.lock);
+    fm_pool_grow(nt);
+    if (nt > fm_pool.nworkers+1) nt = fm_pool.nworkers+1;
+    fm_pool.func = func;
+    fm_pool.x = x;
+    fm_pool.y = y;
+    fm_pool.n = n;
+    fm_pool.nactive = nt;
+    fm_pool.pending = nt-1;
+    ++fm_pool.gen;
+    pthread_cond_broadcast(&fm_pool.work);
+    pthread_mutex_unlock(&fm_pool.lock);
+
+    fm_pool_run(func, x, y, n, 0, nt);
+
+    pthread_mutex_lock(&fm_pool.lock);
+    while (fm_pool.pending > 0)
+        pthread_cond_wait(&fm_pool.done, &fm_pool.lock);
+    pthread_mutex_unlock(&fm_pool.lock);
+    pthread_mutex_unlock(&fm_pool.busy);
+}
+
+#define FM_BATCH_MT_DEF(name)                                   \
+    void name ## _v_mt(const double *x, double *y, size_t n)    \
+    {                                                           \
+        fm_batch_mt(name ## _v, x, y, n);                       \
+    }
+
+FM_BATCH_MT_DEF(fm_exp2)
+FM_BATCH_MT_DEF(fm_exp)
+FM_BATCH_MT_DEF(fm_exp10)
+FM_BATCH_MT_DEF(fm_log2)
+FM_BATCH_MT_DEF(fm_log)
+FM_BATCH_MT_DEF(fm_log10)
+
+/* 
+ * Local Variables:
+ * mode: c
+ * compile-command: "make -C .."
+ * c-basic-offset: 4
+ * fill-column: 76 
+ * indent-tabs-mode: nil 
+ * End: 
+ */
@@ -30,17 +30,23 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fastermath.h"
 
 #ifndef LIBM_ALIAS
-double log(double x) { return fm_log(x); }
-double log2(double x) { return fm_log2(x); }
-double log10(double x) { return fm_log10(x); }
-
+double log(double x) { return fm_log_ieee(x); }
+double log2(double x) { return fm_log2_ieee(x); }
+double log10(double x) { return fm_log10_ieee(x); }
+
+#if defined(__FMA__)
+double exp(double x) { return fm_exp_fma(x); }
+double exp2(double x) { return fm_exp2_fma(x); }
+double exp10(double x) { return fm_exp10_fma(x); }
+#else
 double exp(double x) { return fm_exp(x); }
 double exp2(double x) { return fm_exp2(x); }
 double exp10(double x) { return fm_exp10(x); }
+#endif
 
-float logf(float x) { return fm_logf(x); }
-float log2f(float x) { return fm_log2f(x); }
-float log10f(float x) { return fm_log10f(x); }
+float logf(float x) { return fm_logf_ieee(x); }
+float log2f(float x) { return fm_log2f_ieee(x); }
+float log10f(float x) { return fm_log10f_ieee(x); }
 
 float expf(float x) { return fm_expf(x); }
 float exp2f(float x) { return fm_exp2f(x); }